@@ -0,0 +1,212 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../src/utility.h"
+#include "../src/keccak_dispatch.h"
+#include "../src/Atom.h"
+#include "../src/Molecule.h"
+#include "../src/Wallet.h"
+#include "../src/KnishIOClient.h"
+
+/**
+ * KnishIO C++ SDK Microbenchmarks
+ *
+ * Timings for the crypto and molecule hot paths: SHAKE256, the Keccak
+ * backends, wallet derivation, molecular hashing, signing, OTS verification,
+ * JSON and binary round trips and ML-KEM768 encryption. Inputs are fixed
+ * (seeded secrets, canonical positions), so runs of different SDK versions
+ * are directly comparable; the run_benchmarks target records JSON results for
+ * diffing between releases (see README.md).
+ */
+
+namespace {
+
+const std::string SOURCE_POSITION = "aaaa000000000000bbbb111111111111cccc222222222222dddd333333333333";
+const std::string RECIPIENT_POSITION = "bbbb000000000000cccc111111111111dddd222222222222eeee333333333333";
+const std::string REMAINDER_POSITION = "cccc000000000000dddd111111111111eeee222222222222ffff333333333333";
+
+const std::string& sourceSecret() {
+    static const std::string secret = knishio::KnishIOClient::generateSecret(std::string("benchmark-source"));
+    return secret;
+}
+
+const std::string& recipientSecret() {
+    static const std::string secret = knishio::KnishIOClient::generateSecret(std::string("benchmark-recipient"));
+    return secret;
+}
+
+// A 3-atom V-isotope transfer, unsigned
+KnishIO::Molecule unsignedTransfer() {
+    KnishIO::Wallet source(sourceSecret(), "TEST", SOURCE_POSITION);
+    source.balance = "1000";
+    KnishIO::Wallet recipient(recipientSecret(), "TEST", RECIPIENT_POSITION);
+    KnishIO::Wallet remainder(sourceSecret(), "TEST", REMAINDER_POSITION);
+
+    KnishIO::Molecule molecule;
+    molecule.initValue(source, recipient, remainder, "250");
+    // Fixed timestamps keep the molecular hash (and so the chain lengths) stable
+    for (size_t index = 0; index < molecule.atoms.size(); index++) {
+        molecule.atoms[index].createdAt = std::chrono::milliseconds(1700000000000 + static_cast<int64_t>(index) * 1000);
+    }
+    return molecule;
+}
+
+const KnishIO::Molecule& signedTransfer() {
+    static const KnishIO::Molecule molecule = [] {
+        auto signedMolecule = unsignedTransfer();
+        signedMolecule.sign(sourceSecret(), false);
+        return signedMolecule;
+    }();
+    return molecule;
+}
+
+} // namespace
+
+// SHAKE256 with a 512-bit output over inputs from one WOTS+ chunk up to a wallet key
+static void BM_Shake256(benchmark::State& state) {
+    std::string input(static_cast<size_t>(state.range(0)), 'a');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shake256(input, 512));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Shake256)->Arg(128)->Arg(2048)->Arg(4096);
+
+// One Keccak-f[1600] permutation per backend supported by this CPU
+static void BM_KeccakPermute(benchmark::State& state) {
+    auto backend = static_cast<knishio::KeccakBackend>(state.range(0));
+    if (!knishio::keccakBackendSupported(backend)) {
+        state.SkipWithError("backend not supported on this CPU");
+        return;
+    }
+    state.SetLabel(knishio::keccakBackendName(backend));
+    uint64_t lanes[25] = {};
+    for (auto _ : state) {
+        knishio::keccakF1600Permute(backend, lanes);
+        benchmark::DoNotOptimize(lanes);
+    }
+}
+BENCHMARK(BM_KeccakPermute)
+    ->Arg(static_cast<int>(knishio::KeccakBackend::Reference))
+    ->Arg(static_cast<int>(knishio::KeccakBackend::Opt64))
+    ->Arg(static_cast<int>(knishio::KeccakBackend::Opt64Bmi2));
+
+// Full wallet construction; range(0) selects eager key pair generation
+static void BM_WalletConstruction(benchmark::State& state) {
+    auto mode = state.range(0) ? KnishIO::Wallet::KeyGeneration::Eager : KnishIO::Wallet::KeyGeneration::Lazy;
+    state.SetLabel(state.range(0) ? "eager" : "lazy");
+    KnishIO::Wallet::setKeyGeneration(mode);
+    for (auto _ : state) {
+        KnishIO::Wallet wallet(sourceSecret(), "TEST", SOURCE_POSITION);
+        benchmark::DoNotOptimize(wallet.address);
+    }
+    KnishIO::Wallet::setKeyGeneration(KnishIO::Wallet::KeyGeneration::Lazy);
+}
+BENCHMARK(BM_WalletConstruction)->Arg(0)->Arg(1);
+
+static void BM_GenerateWalletKey(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(KnishIO::Wallet::generateWalletKey(sourceSecret(), "TEST", SOURCE_POSITION));
+    }
+}
+BENCHMARK(BM_GenerateWalletKey);
+
+static void BM_GenerateWalletAddress(benchmark::State& state) {
+    auto key = KnishIO::Wallet::generateWalletKey(sourceSecret(), "TEST", SOURCE_POSITION);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(KnishIO::Wallet::generateWalletAddress(key));
+    }
+}
+BENCHMARK(BM_GenerateWalletAddress);
+
+static void BM_HashAtomsBase17(benchmark::State& state) {
+    const auto& molecule = signedTransfer();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(KnishIO::Atom::hashAtomsBase17(molecule.atoms));
+    }
+}
+BENCHMARK(BM_HashAtomsBase17);
+
+// Includes copying the unsigned molecule, which is small next to the signature
+static void BM_MoleculeSign(benchmark::State& state) {
+    const auto molecule = unsignedTransfer();
+    for (auto _ : state) {
+        auto copy = molecule;
+        benchmark::DoNotOptimize(copy.sign(sourceSecret(), false));
+    }
+}
+BENCHMARK(BM_MoleculeSign);
+
+static void BM_MoleculeVerifyOts(benchmark::State& state) {
+    const auto& molecule = signedTransfer();
+    if (!KnishIO::Molecule::verifyOts(molecule)) {
+        state.SkipWithError("signed molecule does not verify");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(KnishIO::Molecule::verifyOts(molecule));
+    }
+}
+BENCHMARK(BM_MoleculeVerifyOts);
+
+static void BM_MoleculeToJson(benchmark::State& state) {
+    const auto& molecule = signedTransfer();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(molecule.toJson());
+    }
+}
+BENCHMARK(BM_MoleculeToJson);
+
+static void BM_MoleculeJsonToObject(benchmark::State& state) {
+    const auto json = signedTransfer().toJson();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(KnishIO::Molecule::jsonToObject(json));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_MoleculeJsonToObject);
+
+static void BM_MoleculeToBinary(benchmark::State& state) {
+    const auto& molecule = signedTransfer();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(molecule.toBinary());
+    }
+}
+BENCHMARK(BM_MoleculeToBinary);
+
+static void BM_MoleculeBinaryToObject(benchmark::State& state) {
+    const auto binary = signedTransfer().toBinary();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(KnishIO::Molecule::binaryToObject(binary));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(binary.size()));
+}
+BENCHMARK(BM_MoleculeBinaryToObject);
+
+#ifdef HAVE_MLKEM_NATIVE
+static void BM_MLKEM768Encrypt(benchmark::State& state) {
+    KnishIO::Wallet sender(sourceSecret(), "TEST", SOURCE_POSITION);
+    KnishIO::Wallet recipient(recipientSecret(), "TEST", RECIPIENT_POSITION);
+    const auto recipientKey = toBase64(recipient.getMlkemPublicKey());
+    const std::string message(static_cast<size_t>(state.range(0)), 'm');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sender.encryptMessageML768(message, recipientKey));
+    }
+}
+BENCHMARK(BM_MLKEM768Encrypt)->Arg(256)->Arg(16384);
+
+static void BM_MLKEM768Decrypt(benchmark::State& state) {
+    KnishIO::Wallet sender(sourceSecret(), "TEST", SOURCE_POSITION);
+    KnishIO::Wallet recipient(recipientSecret(), "TEST", RECIPIENT_POSITION);
+    const std::string message(static_cast<size_t>(state.range(0)), 'm');
+    const auto envelope = sender.encryptMessageML768(message, toBase64(recipient.getMlkemPublicKey()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(recipient.decryptMessageML768(envelope));
+    }
+}
+BENCHMARK(BM_MLKEM768Decrypt)->Arg(256)->Arg(16384);
+#endif
+
+BENCHMARK_MAIN();
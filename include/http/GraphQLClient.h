@@ -5,12 +5,13 @@
 #include <chrono>
 #include <future>
 #include <optional>
+#include <string_view>
 #include <unordered_map>
 #include <curl/curl.h>
 #include "third_party/nlohmann/json.hpp"
 
 // PQ-transport (Phase E): the AUTH source wallet that en/decrypts the ML-KEM CipherHash envelope.
-namespace KnishIO { class Wallet; }
+namespace KnishIO { class Wallet; class CipherSession; }
 
 namespace knishio {
 namespace http {
@@ -28,20 +29,59 @@ class GraphQLClient {
 public:
     /**
      * HTTP response structure
+     *
+     * The body is a pooled buffer that curl wrote into directly (sized from Content-Length);
+     * hand the response to recycle() once it has been parsed and the buffer serves the next one.
      */
     struct Response {
-        int statusCode;                                    ///< HTTP status code
+        int statusCode = 0;                                ///< HTTP status code (0 when there is no usable response)
         std::string body;                                  ///< Response body
-        std::unordered_map<std::string, std::string> headers; ///< Response headers
+        std::unordered_map<std::string, std::string> headers; ///< Response headers; empty until parseHeaders() (read them with header())
         std::optional<std::string> error;                  ///< Error message if failed
+        std::string rawHeaders;                            ///< Header block of the final response, as received
         
         [[nodiscard]] bool isSuccess() const noexcept {
             return statusCode >= 200 && statusCode < 300;
         }
+
+        /**
+         * Look up a response header, parsed from rawHeaders on demand
+         * @param name Header name (case-insensitive)
+         * @note Falls back to headers when rawHeaders is empty (a hand-built response)
+         * @return The trimmed value, a view into rawHeaders, or nullopt if absent
+         */
+        [[nodiscard]] std::optional<std::string_view> header(std::string_view name) const;
+
+        /**
+         * Fill headers from rawHeaders, for code that reads the map
+         * @note Copies every name and value; header() looks one up without copying
+         */
+        void parseHeaders();
         
         [[nodiscard]] nlohmann::json toJson() const;
     };
     
+    /**
+     * What a request's operation is, as far as the transport cares
+     *
+     * Decides the CipherHash bypass (schema introspection, ContinuId, AccessToken and the
+     * U-isotope ProposeMolecule travel in plaintext) without re-reading the query per attempt.
+     */
+    struct OperationDescriptor {
+        enum class Kind { Query, Mutation, Subscription };
+
+        Kind kind = Kind::Query;                           ///< Operation type of the first definition
+        std::string rootField;                             ///< First field of its selection set (not the alias)
+        bool uIsotope = false;                             ///< ProposeMolecule of a U-isotope (auth) molecule
+
+        /**
+         * Classify a raw GraphQL document with a single forward scan
+         * @param query The GraphQL query string
+         * @return The descriptor; uIsotope is left false, it depends on the variables
+         */
+        [[nodiscard]] static OperationDescriptor scan(std::string_view query);
+    };
+
     /**
      * GraphQL request structure
      */
@@ -49,7 +89,14 @@ public:
         std::string query;                                 ///< GraphQL query string
         std::optional<nlohmann::json> variables;           ///< Query variables
         std::optional<std::string> operationName;          ///< Operation name
+        std::optional<OperationDescriptor> operation;      ///< Classified once; scanned from query when unset
         
+        /**
+         * Build a request whose operation is classified up front, for queries sent repeatedly
+         * @param query The GraphQL query string
+         */
+        [[nodiscard]] static Request prepare(std::string query);
+
         [[nodiscard]] std::string toJsonString() const;
     };
     
@@ -112,6 +159,13 @@ public:
      * @return Future containing the response
      */
     [[nodiscard]] std::future<Response> execute(const Request& request);
+
+    /**
+     * Execute a raw GraphQL request, taking over its query and variables
+     * @param request The request to execute
+     * @return Future containing the response
+     */
+    [[nodiscard]] std::future<Response> execute(Request&& request);
     
     /**
      * Set authorization token
@@ -135,6 +189,16 @@ public:
      * validator's advertised ML-KEM public key (base64). Set once at auth.
      */
     void setCipherContext(std::shared_ptr<KnishIO::Wallet> wallet, const std::string& serverPubKey);
+
+    /**
+     * Opt into ML-KEM session keys for the encrypted transport: one encapsulation per session,
+     * per-request AES-256-GCM keys derived from it (see KnishIO::CipherSession). A session is
+     * replaced after maxRequests requests or maxAge, whichever comes first. The validator must
+     * support session envelopes.
+     * @param maxRequests Requests per session; 0 returns to single-shot envelopes
+     * @param maxAge Session lifetime
+     */
+    void setCipherSession(size_t maxRequests, std::chrono::seconds maxAge);
     
     /**
      * Set custom header
@@ -179,6 +243,14 @@ public:
      */
     void setVerifySSL(bool verify);
 
+    /**
+     * Opt into the process-wide DNS, TLS session and connection cache shared by every client
+     * that enables it, so clients created for a node another client already uses skip the
+     * TLS handshake
+     * @param share True to use the shared cache; false (default) keeps a private TLS session cache
+     */
+    void setSharedSession(bool share);
+
     /**
      * Check if the client is connected (last request succeeded)
      * @return True if the last request succeeded
@@ -190,6 +262,13 @@ public:
      * @return Map of statistics (total_requests, failed_requests, etc.)
      */
     [[nodiscard]] std::unordered_map<std::string, size_t> getStats() const;
+
+    /**
+     * Return a parsed response's body buffer to the transport's pool, so the next response is
+     * written into memory that is already there
+     * @param response The response, left with an empty body
+     */
+    static void recycle(Response&& response) noexcept;
     
 private:
     // Private implementation (pImpl idiom)
@@ -197,8 +276,7 @@ private:
     std::unique_ptr<Impl> pImpl_;
     
     // Internal methods
-    [[nodiscard]] Response executeInternal(const Request& request);
-    [[nodiscard]] Response executeWithRetry(const Request& request);
+    [[nodiscard]] std::future<Response> submit(Request request);
     
     // CURL callback functions
     static size_t writeCallback(char* ptr, size_t size, size_t nmemb, void* userdata);
@@ -206,9 +284,6 @@ private:
     
     void initializeCurl();
     void cleanupCurl();
-    void setupRequestHeaders(CURL* curl, const Request& request);
-    [[nodiscard]] Response parseCurlResponse(CURL* curl, const std::string& responseBody,
-                                            const std::unordered_map<std::string, std::string>& headers);
 };
 
 /**
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <memory>
 #include <vector>
@@ -90,6 +91,14 @@ public:
      * Parse response data into balance structure
      */
     void parseData();
+
+    /**
+     * Parse a GraphQL HTTP body ({"data":{"Balance":{...}}}) straight into the balance
+     * structure with a streaming parser; getData() stays empty
+     * @param body The raw response body
+     * @return false if the body is not valid JSON
+     */
+    bool parseBody(std::string_view body);
     
 private:
     std::optional<Balance> balance;
@@ -121,6 +130,14 @@ public:
      * Parse response data into wallet list
      */
     void parseData();
+
+    /**
+     * Parse a GraphQL HTTP body ({"data":{"wallets":[...]}}) straight into the wallet list with a
+     * streaming parser, without building a JSON tree of the whole list; getData() stays empty
+     * @param body The raw response body
+     * @return false if the body is not valid JSON
+     */
+    bool parseBody(std::string_view body);
     
 private:
     std::vector<Wallet> wallets;
@@ -150,6 +167,14 @@ public:
      * Parse response data into ContinuID structure
      */
     void parseData();
+
+    /**
+     * Parse a GraphQL HTTP body ({"data":{"ContinuId":{...}}}) straight into the ContinuID
+     * structure with a streaming parser; getData() stays empty
+     * @param body The raw response body
+     * @return false if the body is not valid JSON
+     */
+    bool parseBody(std::string_view body);
     
 private:
     std::optional<ContinuID> continuId;
@@ -265,6 +290,14 @@ public:
      * @return Rejection reason or empty string
      */
     [[nodiscard]] std::string getRejectionReason() const;
+
+    /**
+     * Parse a GraphQL HTTP body with a streaming parser, keeping only the ProposeMolecule
+     * fields (molecularHash, status, reason, payload, createdAt) and any GraphQL errors as data
+     * @param body The raw response body
+     * @return false if the body is not valid JSON
+     */
+    bool parseBody(std::string_view body);
 };
 
 } // namespace response
@@ -1183,14 +1183,14 @@ private:
             Logger::test("Encryption wallet creation", true);
             
             // JavaScript pattern: Check ML-KEM768 public key generation
-            bool public_key_generated = !encryption_wallet.mlkem_public_key.empty();
+            bool public_key_generated = !encryption_wallet.getMlkemPublicKey().empty();
             Logger::test("ML-KEM768 public key generation", public_key_generated);
 
             // Cycle 143: AES-256-GCM now runs via OpenSSL EVP (portable, no AES-NI gate) →
             // the encrypt/decrypt roundtrip runs unconditionally on every platform.
 
             // JavaScript pattern: Test self-encryption
-            auto public_key_b64 = toBase64(encryption_wallet.mlkem_public_key);
+            auto public_key_b64 = toBase64(encryption_wallet.getMlkemPublicKey());
             auto encrypted_data = encryption_wallet.encryptMessageML768("Hello ML-KEM768 cross-platform test message!", public_key_b64);
             
             bool encryption_success = !encrypted_data["cipherText"].empty() && !encrypted_data["encryptedMessage"].empty();
@@ -1254,7 +1254,7 @@ private:
 
             // --- keygen assertion (mlkem-native is portable) ---
             Wallet w(kg.at("secret").get<std::string>(), kg.at("token").get<std::string>(), kg.at("position").get<std::string>());
-            std::string pubkey_b64 = toBase64(w.mlkem_public_key);
+            std::string pubkey_b64 = toBase64(w.getMlkemPublicKey());
             bool keygen_ok = (pubkey_b64 == kg.at("expectedPubkey").get<std::string>());
             Logger::test("ML-KEM768 keygen pubkey matches vector", keygen_ok);
 
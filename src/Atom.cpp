@@ -3,7 +3,11 @@
 #include "third_party/nlohmann/json.hpp"
 #include "third_party/Keccak/Keccak.h"
 #include "utility.h"
+#include "shake256.h"
+#include "encoding.h"
 #include <array>
+#include <charconv>
+#include <type_traits>
 
 using namespace std::chrono;
 
@@ -30,7 +34,24 @@ Atom::Atom(const std::string &position, const std::string &walletAddress, const
 {
 }
 
-Atom Atom::jsonToObject(const std::string &jsonStr)
+namespace {
+
+// String fields are moved out of a node the caller gave up, copied from a const one
+template<typename Json>
+std::string takeString(Json &value)
+{
+	if constexpr (std::is_const_v<Json>)
+	{
+		return value.template get<std::string>();
+	}
+	else
+	{
+		return std::move(value.template get_ref<std::string &>());
+	}
+}
+
+template<typename Json>
+Atom atomFromJson(Json &json)
 {
 	const char *c_values[] =
 	{
@@ -45,10 +66,9 @@ Atom Atom::jsonToObject(const std::string &jsonStr)
 		"meta",
 		"otsFragment",
 		"createdAt",
+		"index",
 	};
 
-	nlohmann::json json = nlohmann::json::parse(jsonStr);
-
 	Atom atom("", "", "");
 
 	for (size_t i = 0; i < std::size(c_values); i++)
@@ -60,42 +80,42 @@ Atom Atom::jsonToObject(const std::string &jsonStr)
 			switch (i)
 			{
 			case 0:
-				atom.position = value->get<std::string>();
+				atom.position = takeString(*value);
 				break;
 
 			case 1:
-				atom.walletAddress = value->get<std::string>();
+				atom.walletAddress = takeString(*value);
 				break;
 
 			case 2:
-				atom.isotope = value->get<std::string>();
+				atom.isotope = takeString(*value);
 				break;
 
 			case 3:
-				atom.token = value->get<std::string>();
+				atom.token = takeString(*value);
 				break;
 
 			case 4:
 				if (!value->is_null()) {
-					atom.value = value->get<std::string>();
+					atom.value = takeString(*value);
 				}
 				break;
 
 			case 5:
 				if (!value->is_null()) {
-					atom.batchId = value->get<std::string>();
+					atom.batchId = takeString(*value);
 				}
 				break;
 
 			case 6:
 				if (!value->is_null()) {
-					atom.metaType = value->get<std::string>();
+					atom.metaType = takeString(*value);
 				}
 				break;
 
 			case 7:
 				if (!value->is_null()) {
-					atom.metaId = value->get<std::string>();
+					atom.metaId = takeString(*value);
 				}
 				break;
 
@@ -107,8 +127,8 @@ Atom Atom::jsonToObject(const std::string &jsonStr)
 				{
 					if (key_value.find("key") != key_value.end() && key_value.find("value") != key_value.end())
 					{
-						auto key = key_value["key"].get<std::string>();
-						const auto &metaVal = key_value["value"];
+						auto key = takeString(key_value["key"]);
+						auto &metaVal = key_value["value"];
 
 						// Cross-SDK meta values are not always strings: an absent optional key (e.g.
 						// walletBatchId) may be serialized as null — every SDK SKIPS null meta in the
@@ -118,31 +138,37 @@ Atom Atom::jsonToObject(const std::string &jsonStr)
 						if (metaVal.is_null()) {
 							continue;
 						}
-						auto value = metaVal.is_string() ? metaVal.get<std::string>() : metaVal.dump();
+						auto value = metaVal.is_string() ? takeString(metaVal) : metaVal.dump();
 
-						metaValues.push_back({key, value});
+						metaValues.emplace_back(std::move(key), std::move(value));
 					}
 				}
 
-				atom.meta = metaValues;
+				atom.meta = std::move(metaValues);
 				break;
 			}
 
 			case 9:
 				if (!value->is_null()) {
-					atom.otsFragment = value->get<std::string>();
+					atom.otsFragment = takeString(*value);
 				}
 				break;
 
 			case 10:
 			{
-				auto createdAtStr = value->get<std::string>();
+				auto createdAtStr = takeString(*value);
 				auto createdAt = std::strtoll(createdAtStr.c_str(), NULL, 10);
 
 				atom.createdAt = std::chrono::milliseconds(createdAt);
 				break;
 			}
 
+			case 11:
+				if (value->is_number_integer()) {
+					atom.index = value->template get<int>();
+				}
+				break;
+
 			}
 		}
 	}
@@ -150,49 +176,63 @@ Atom Atom::jsonToObject(const std::string &jsonStr)
 	return atom;
 }
 
+} // namespace
+
+Atom Atom::jsonToObject(const std::string &jsonStr)
+{
+	return fromJson(nlohmann::json::parse(jsonStr));
+}
+
+Atom Atom::fromJson(const nlohmann::json &json)
+{
+	return atomFromJson(json);
+}
+
+Atom Atom::fromJson(nlohmann::json &&json)
+{
+	return atomFromJson(json);
+}
+
 std::vector<unsigned char> Atom::hashAtoms(const std::vector<Atom> &atoms)
 {
-	std::string molecularSponge;
+	// Fields are streamed straight into the sponge; the byte sequence is the same
+	// concatenation the JavaScript/C implementations build as a string.
+	knishio::Shake256 molecularSponge;
+
+	const std::string atomCount = std::to_string(atoms.size());
+	char createdAtBuffer[24];
 
 	for (const auto &atom : atoms)
 	{
 		// Number of atoms (appended per atom — matches JavaScript/C logic)
-		molecularSponge.append(std::to_string(atoms.size()));
+		molecularSponge.update(atomCount);
 
 		// Required fields
-		molecularSponge.append(atom.position);
-		molecularSponge.append(atom.walletAddress);
-		molecularSponge.append(atom.isotope);
-
-		// Optional fields — appended only when non-empty (matches JavaScript/C logic)
-		if (!atom.token.empty()) {
-			molecularSponge.append(atom.token);
-		}
-		if (!atom.value.empty()) {
-			molecularSponge.append(atom.value);
-		}
-		if (!atom.batchId.empty()) {
-			molecularSponge.append(atom.batchId);
-		}
-		if (!atom.metaType.empty()) {
-			molecularSponge.append(atom.metaType);
-		}
-		if (!atom.metaId.empty()) {
-			molecularSponge.append(atom.metaId);
-		}
+		molecularSponge.update(atom.position);
+		molecularSponge.update(atom.walletAddress);
+		molecularSponge.update(atom.isotope);
+
+		// Optional fields — appended only when non-empty (matches JavaScript/C logic);
+		// absorbing an empty string is a no-op, so they can be fed unconditionally
+		molecularSponge.update(atom.token);
+		molecularSponge.update(atom.value);
+		molecularSponge.update(atom.batchId);
+		molecularSponge.update(atom.metaType);
+		molecularSponge.update(atom.metaId);
 
 		// Meta key/value pairs (every pair, even empty values — matches JavaScript/C logic)
 		for (const auto &meta : atom.meta)
 		{
-			molecularSponge.append(meta.first);   // key
-			molecularSponge.append(meta.second);  // value (even if empty string)
+			molecularSponge.update(meta.first);   // key
+			molecularSponge.update(meta.second);  // value (even if empty string)
 		}
 
 		// createdAt (required field)
-		molecularSponge.append(std::to_string(atom.createdAt.count()));
+		auto createdAt = std::to_chars(createdAtBuffer, createdAtBuffer + sizeof(createdAtBuffer), atom.createdAt.count());
+		molecularSponge.update(std::string_view(createdAtBuffer, static_cast<size_t>(createdAt.ptr - createdAtBuffer)));
 	}
 
-	return shake256(molecularSponge, 256);
+	return molecularSponge.digest(256);
 }
 
 std::string Atom::hashAtomsHex(const std::vector<Atom> &atoms)
@@ -204,12 +244,12 @@ std::string Atom::hashAtomsHex(const std::vector<Atom> &atoms)
 
 std::string Atom::hashAtomsBase17(const std::vector<Atom> &atoms)
 {
-	auto hashHex = hashAtomsHex(atoms);
-
-	auto hashConverted = charsetBaseConvert(hashHex, 16, 17, "0123456789abcdefg");
+	auto hash = hashAtoms(atoms);
 
-	// pad with zeroes in the beginning
-	hashConverted.insert(hashConverted.begin(), hashConverted.size() < 64 ? 64 - hashConverted.size() : 0, '0');
+	// Fixed-width conversion, zero-padded to 64 digits; matches
+	// charsetBaseConvert(hashHex, 16, 17, "0123456789abcdefg") padded with '0'
+	std::string hashConverted(knishio::BASE17_DIGITS_256, '0');
+	knishio::base17Encode256(std::span<const unsigned char, 32>(hash.data(), 32), hashConverted.data());
 
 	return hashConverted;
 }
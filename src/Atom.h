@@ -10,6 +10,8 @@
 #include <map>
 #include <chrono>
 
+#include "third_party/nlohmann/json.hpp"
+
 namespace KnishIO {
 
 /**
@@ -24,6 +26,9 @@ public:
 		, const std::string &metaId = {}, const std::vector<std::pair<std::string, std::string>> &meta = {}, const std::string &otsFragment = {}, int index = 0);
 
 	static Atom jsonToObject(const std::string &json);
+	// Decodes an already parsed atom node; the rvalue overload moves its strings into the Atom
+	static Atom fromJson(const nlohmann::json &json);
+	static Atom fromJson(nlohmann::json &&json);
 
 	static std::vector<unsigned char> hashAtoms(const std::vector<Atom> &atoms);
 	static std::string hashAtomsHex(const std::vector<Atom> &atoms);
@@ -0,0 +1,160 @@
+#include "ChainPipeline.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace knishio {
+
+namespace {
+
+enum class JobState : unsigned char {
+    Pending,
+    Preparing,
+    Ready,
+    Failed
+};
+
+struct ChainState {
+    const std::vector<size_t>* jobs = nullptr;
+    std::vector<JobState> states;
+    size_t nextToPrepare = 0;
+    size_t submitted = 0;
+    bool active = false;
+};
+
+template<typename F>
+bool runGuarded(const F& callback, size_t job) {
+    try {
+        return callback(job);
+    } catch (...) {
+        return false;
+    }
+}
+
+} // anonymous namespace
+
+ChainPipeline::ChainPipeline(Options options)
+    : options_(options) {
+    if (options_.workers == 0) {
+        options_.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    options_.window = std::max<size_t>(options_.window, 1);
+    options_.maxChains = std::max<size_t>(options_.maxChains, 1);
+}
+
+ChainPipeline::ChainPipeline()
+    : ChainPipeline(Options{}) {
+}
+
+void ChainPipeline::run(const std::vector<std::vector<size_t>>& chains,
+                        const Prepare& prepare,
+                        const Submit& submit,
+                        const Cancel& cancel) const {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<ChainState> state(chains.size());
+    for (size_t index = 0; index < chains.size(); index++) {
+        state[index].jobs = &chains[index];
+        state[index].states.assign(chains[index].size(), JobState::Pending);
+    }
+    size_t nextChain = 0;
+    size_t chainsDone = 0;
+    const size_t window = options_.window;
+
+    // Workers prepare the next job of any active chain with room in its window
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            ChainState* claimed = nullptr;
+            for (auto& chain : state) {
+                if (chain.active && chain.nextToPrepare < chain.jobs->size() &&
+                    chain.nextToPrepare < chain.submitted + window) {
+                    claimed = &chain;
+                    break;
+                }
+            }
+            if (!claimed) {
+                if (chainsDone == state.size()) {
+                    return;
+                }
+                changed.wait(lock);
+                continue;
+            }
+
+            size_t position = claimed->nextToPrepare++;
+            claimed->states[position] = JobState::Preparing;
+            size_t job = (*claimed->jobs)[position];
+            lock.unlock();
+            bool prepared = runGuarded(prepare, job);
+            lock.lock();
+            claimed->states[position] = prepared ? JobState::Ready : JobState::Failed;
+            changed.notify_all();
+        }
+    };
+
+    // Submitters take one chain at a time and submit its jobs in order
+    auto submitter = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (nextChain < state.size()) {
+            ChainState& chain = state[nextChain++];
+            chain.active = true;
+            changed.notify_all();
+
+            const auto& jobs = *chain.jobs;
+            size_t position = 0;
+            for (; position < jobs.size(); position++) {
+                changed.wait(lock, [&] {
+                    return chain.states[position] == JobState::Ready || chain.states[position] == JobState::Failed;
+                });
+                if (chain.states[position] == JobState::Failed) {
+                    position++;
+                    break;
+                }
+                lock.unlock();
+                bool submitted = runGuarded(submit, jobs[position]);
+                lock.lock();
+                chain.submitted++;
+                changed.notify_all();
+                if (!submitted) {
+                    position++;
+                    break;
+                }
+            }
+
+            // Stop preparing this chain, let in-progress preparations land, then cancel the rest
+            chain.active = false;
+            changed.wait(lock, [&] {
+                return std::none_of(chain.states.begin(), chain.states.end(),
+                                    [](JobState job) { return job == JobState::Preparing; });
+            });
+            for (; position < jobs.size(); position++) {
+                if (chain.states[position] != JobState::Failed) {
+                    lock.unlock();
+                    try {
+                        cancel(jobs[position]);
+                    } catch (...) {
+                    }
+                    lock.lock();
+                }
+            }
+            chainsDone++;
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    size_t submitters = std::min(options_.maxChains, chains.size());
+    threads.reserve(options_.workers + submitters);
+    for (size_t index = 0; index < submitters; index++) {
+        threads.emplace_back(submitter);
+    }
+    for (size_t index = 0; index < options_.workers; index++) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace knishio
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace knishio {
+
+/**
+ * Prepare-in-parallel, submit-in-order job pipeline
+ *
+ * Jobs are grouped into chains. Within a chain, job k+1 depends on job k
+ * having been submitted (e.g. a transfer spending the remainder wallet of the
+ * previous one), so a chain's jobs are submitted strictly in order, one at a
+ * time. Preparation (signing) has no such dependency and runs on a worker
+ * pool, ahead of submission, bounded by a per-chain window: a chain never
+ * holds more than `window` prepared jobs that have not been submitted yet.
+ * Up to maxChains chains submit concurrently.
+ *
+ * The callbacks must not throw; an exception counts as a failure.
+ */
+class ChainPipeline {
+public:
+    struct Options {
+        size_t workers = 0;         ///< Preparation threads (0 = hardware concurrency)
+        size_t window = 32;         ///< Prepared-but-unsubmitted jobs allowed per chain
+        size_t maxChains = 4;       ///< Chains submitting concurrently
+    };
+
+    /**
+     * Prepare one job on a worker thread
+     * @return False if the job failed; the rest of its chain is cancelled
+     */
+    using Prepare = std::function<bool(size_t job)>;
+
+    /**
+     * Submit one prepared job on its chain's submitter thread
+     * @return False if the job failed; the rest of its chain is cancelled
+     */
+    using Submit = std::function<bool(size_t job)>;
+
+    /**
+     * Called once for every job that is neither submitted nor failed in preparation
+     */
+    using Cancel = std::function<void(size_t job)>;
+
+    explicit ChainPipeline(Options options);
+    ChainPipeline();
+
+    /**
+     * Run every chain to completion; returns when all jobs were submitted, failed or cancelled
+     * @param chains Job ids per chain, in submission order
+     */
+    void run(const std::vector<std::vector<size_t>>& chains,
+             const Prepare& prepare,
+             const Submit& submit,
+             const Cancel& cancel) const;
+
+private:
+    Options options_;
+};
+
+} // namespace knishio
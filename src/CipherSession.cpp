@@ -0,0 +1,424 @@
+#include "CipherSession.h"
+
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <sodium.h>
+
+#include "Wallet.h"
+#include "aead.h"
+#include "encoding.h"
+#include "utility.h"
+#include "third_party/nlohmann/json.hpp"
+
+namespace KnishIO {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t SESSION_ID_BYTES = 16;
+constexpr size_t MESSAGE_KEY_MATERIAL = knishio::AEAD_KEY_SIZE + knishio::AEAD_NONCE_SIZE;
+constexpr std::string_view ROOT_INFO = "KnishIO CipherHash session v1";
+
+// HKDF-SHA256 (RFC 5869); an empty salt means expand only, with key as the pseudorandom key
+void hkdf(std::span<const uint8_t> key, std::string_view salt, std::span<const uint8_t> info, std::span<uint8_t> out)
+{
+	EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+	size_t length = out.size();
+	bool ok = ctx != nullptr
+		&& EVP_PKEY_derive_init(ctx) > 0
+		&& EVP_PKEY_CTX_hkdf_mode(ctx, salt.empty() ? EVP_PKEY_HKDEF_MODE_EXPAND_ONLY : EVP_PKEY_HKDEF_MODE_EXTRACT_AND_EXPAND) > 0
+		&& EVP_PKEY_CTX_set_hkdf_md(ctx, EVP_sha256()) > 0
+		&& (salt.empty() || EVP_PKEY_CTX_set1_hkdf_salt(ctx, reinterpret_cast<const unsigned char *>(salt.data()), static_cast<int>(salt.size())) > 0)
+		&& EVP_PKEY_CTX_set1_hkdf_key(ctx, key.data(), static_cast<int>(key.size())) > 0
+		&& EVP_PKEY_CTX_add1_hkdf_info(ctx, info.data(), static_cast<int>(info.size())) > 0
+		&& EVP_PKEY_derive(ctx, out.data(), &length) > 0
+		&& length == out.size();
+	EVP_PKEY_CTX_free(ctx);
+	if (!ok)
+	{
+		throw std::runtime_error("HKDF-SHA256 derivation failed");
+	}
+}
+
+// Key ‖ nonce of one message
+void messageKey(std::span<const uint8_t, 32> root, CipherSession::Keys::Direction direction, uint64_t sequence, uint8_t (&material)[MESSAGE_KEY_MATERIAL])
+{
+	std::string_view label = direction == CipherSession::Keys::Direction::Request ? "request" : "response";
+	uint8_t info[16];
+	std::memcpy(info, label.data(), label.size());
+	for (size_t index = 0; index < 8; index++)
+	{
+		info[label.size() + index] = static_cast<uint8_t>(sequence >> (56 - 8 * index));
+	}
+	hkdf(root, {}, {info, label.size() + 8}, material);
+}
+
+// Picks the entry under one hashShare key out of an envelope map without building a JSON tree
+class SessionEntrySax : public nlohmann::json::json_sax_t
+{
+public:
+	explicit SessionEntrySax(const std::string &shareKey)
+		: shareKey_(shareKey)
+	{
+	}
+
+	bool found = false;
+	std::string cipherText;
+	std::string encryptedMessage;
+	std::optional<std::string> session;
+	std::optional<uint64_t> sequence;
+
+	bool null() override { return true; }
+	bool boolean(bool) override { return true; }
+	bool number_integer(number_integer_t) override { return true; }
+	bool number_float(number_float_t, const string_t &) override { return true; }
+	bool binary(binary_t &) override { return true; }
+
+	bool number_unsigned(number_unsigned_t value) override
+	{
+		if (inEntry_ && depth_ == 2 && field_ == "sequence")
+		{
+			sequence = value;
+		}
+		return true;
+	}
+
+	bool string(string_t &value) override
+	{
+		if (inEntry_ && depth_ == 2)
+		{
+			if (field_ == "cipherText")
+			{
+				cipherText = std::move(value);
+			}
+			else if (field_ == "encryptedMessage")
+			{
+				encryptedMessage = std::move(value);
+			}
+			else if (field_ == "session")
+			{
+				session = std::move(value);
+			}
+		}
+		return true;
+	}
+
+	bool start_object(std::size_t) override
+	{
+		depth_++;
+		if (depth_ == 2 && entryKey_)
+		{
+			inEntry_ = true;
+			found = true;
+		}
+		return true;
+	}
+
+	bool key(string_t &name) override
+	{
+		if (depth_ == 1)
+		{
+			entryKey_ = name == shareKey_;
+		}
+		else if (depth_ == 2)
+		{
+			field_.assign(name);
+		}
+		return true;
+	}
+
+	bool end_object() override
+	{
+		if (depth_ == 2)
+		{
+			inEntry_ = false;
+		}
+		depth_--;
+		return true;
+	}
+
+	bool start_array(std::size_t) override
+	{
+		depth_++;
+		return true;
+	}
+
+	bool end_array() override
+	{
+		depth_--;
+		return true;
+	}
+
+	bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override
+	{
+		return false;
+	}
+
+private:
+	const std::string &shareKey_;
+	int depth_ = 0;
+	bool entryKey_ = false;
+	bool inEntry_ = false;
+	std::string field_;
+};
+
+} // anonymous namespace
+
+struct CipherSession::Session
+{
+	Session(std::string id, std::span<const uint8_t, 32> sharedSecret, std::string kemCipherText)
+		: keys(std::move(id), sharedSecret)
+		, cipherText(std::move(kemCipherText))
+		, opened(Clock::now())
+	{
+	}
+
+	Keys				keys;
+	std::string			cipherText;				// the session's ML-KEM768 ciphertext, base64
+	Clock::time_point	opened;
+	uint64_t			issued = 0;				// sequence numbers handed out
+	bool				established = false;	// a response came back, so the validator holds the session
+	bool				invalidated = false;	// the validator lost it; the next request rotates
+};
+
+CipherSession::Keys::Keys(std::string id, std::span<const uint8_t, 32> sharedSecret)
+	: id_(std::move(id))
+{
+	hkdf(sharedSecret, id_, {reinterpret_cast<const uint8_t *>(ROOT_INFO.data()), ROOT_INFO.size()}, root_);
+}
+
+CipherSession::Keys::~Keys()
+{
+	sodium_memzero(root_, sizeof(root_));
+}
+
+void CipherSession::Keys::seal(Direction direction, uint64_t sequence, std::string_view message, std::string &out) const
+{
+	uint8_t material[MESSAGE_KEY_MATERIAL];
+	messageKey(root_, direction, sequence, material);
+
+	std::string sealed(knishio::aeadSealedLength(message.size()), '\0');
+	auto *buffer = reinterpret_cast<uint8_t *>(sealed.data());
+	std::memcpy(buffer, material + knishio::AEAD_KEY_SIZE, knishio::AEAD_NONCE_SIZE);
+	try
+	{
+		knishio::aeadSeal(std::span(material).first<knishio::AEAD_KEY_SIZE>()
+			, {reinterpret_cast<const uint8_t *>(message.data()), message.size()}
+			, {buffer, sealed.size()});
+	}
+	catch (const std::exception &)
+	{
+		sodium_memzero(material, sizeof(material));
+		sodium_memzero(sealed.data(), sealed.size());
+		throw;
+	}
+	sodium_memzero(material, sizeof(material));
+
+	size_t offset = out.size();
+	out.resize(offset + knishio::base64EncodedLength(sealed.size()));
+	knishio::base64Encode({buffer, sealed.size()}, out.data() + offset);
+}
+
+void CipherSession::Keys::open(Direction direction, uint64_t sequence, std::string_view sealed, std::string &out) const
+{
+	uint8_t material[MESSAGE_KEY_MATERIAL];
+	messageKey(root_, direction, sequence, material);
+
+	out.resize(knishio::base64DecodedMaxLength(sealed.size()));
+	auto *buffer = reinterpret_cast<uint8_t *>(out.data());
+	size_t size = knishio::base64Decode(sealed, buffer);
+	size_t length = 0;
+	try
+	{
+		// The nonce is derived too; one that differs means another message's ciphertext
+		if (size < knishio::AEAD_NONCE_SIZE || std::memcmp(buffer, material + knishio::AEAD_KEY_SIZE, knishio::AEAD_NONCE_SIZE) != 0)
+		{
+			throw std::runtime_error("CipherHash session: message nonce does not match its sequence");
+		}
+		length = knishio::aeadOpenInPlace(std::span(material).first<knishio::AEAD_KEY_SIZE>(), {buffer, size});
+	}
+	catch (const std::exception &)
+	{
+		sodium_memzero(material, sizeof(material));
+		out.clear();
+		throw;
+	}
+	sodium_memzero(material, sizeof(material));
+
+	out.erase(0, knishio::AEAD_NONCE_SIZE);
+	out.resize(length);
+}
+
+CipherSession::CipherSession(std::shared_ptr<Wallet> wallet, std::string serverPubKey, Options options)
+	: wallet_(std::move(wallet))
+	, serverPubKey_(std::move(serverPubKey))
+	, options_(options)
+{
+	if (!wallet_)
+	{
+		throw std::invalid_argument("CipherSession needs the wallet that receives responses");
+	}
+	serverShare_ = wallet_->hashShare(serverPubKey_);
+	walletShare_ = wallet_->hashShare(toBase64(wallet_->getMlkemPublicKey()));
+}
+
+CipherSession::CipherSession(std::shared_ptr<Wallet> wallet, std::string serverPubKey)
+	: CipherSession(std::move(wallet), std::move(serverPubKey), Options())
+{
+}
+
+CipherSession::~CipherSession() = default;
+
+void CipherSession::rotate()
+{
+	uint8_t sharedSecret[32];
+	std::string kemCipherText = Wallet::encapsulateML768(serverPubKey_, sharedSecret);
+
+	uint8_t idBytes[SESSION_ID_BYTES];
+	randombytes_buf(idBytes, sizeof(idBytes));
+	std::string id(knishio::hexEncodedLength(sizeof(idBytes)), '\0');
+	knishio::hexEncode(idBytes, id.data());
+
+	auto session = std::make_shared<Session>(std::move(id), sharedSecret, std::move(kemCipherText));
+	sodium_memzero(sharedSecret, sizeof(sharedSecret));
+
+	previous_ = std::move(current_);
+	current_ = std::move(session);
+	opened_++;
+}
+
+CipherSession::RequestTag CipherSession::sealRequest(std::string_view message, std::string &out, bool escaped)
+{
+	std::shared_ptr<Session> session;
+	uint64_t sequence = 0;
+	bool sendCipherText = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!current_
+			|| current_->invalidated
+			|| current_->issued >= options_.maxRequests
+			|| Clock::now() - current_->opened >= options_.maxAge)
+		{
+			rotate();
+		}
+		session = current_;
+		sequence = session->issued++;
+		sendCipherText = !session->established;
+	}
+
+	const std::string_view quote = escaped ? "\\\"" : "\"";
+	out.reserve(out.size() + 160 + (sendCipherText ? session->cipherText.size() : 0)
+		+ knishio::base64EncodedLength(knishio::aeadSealedLength(message.size())));
+	out += '{';
+	out += quote;
+	out += serverShare_;
+	out += quote;
+	out += ":{";
+	if (sendCipherText)
+	{
+		out += quote;
+		out += "cipherText";
+		out += quote;
+		out += ':';
+		out += quote;
+		out += session->cipherText;
+		out += quote;
+		out += ',';
+	}
+	out += quote;
+	out += "encryptedMessage";
+	out += quote;
+	out += ':';
+	out += quote;
+	session->keys.seal(Keys::Direction::Request, sequence, message, out);
+	out += quote;
+	out += ',';
+	out += quote;
+	out += "sequence";
+	out += quote;
+	out += ':';
+	out += std::to_string(sequence);
+	out += ',';
+	out += quote;
+	out += "session";
+	out += quote;
+	out += ':';
+	out += quote;
+	out += session->keys.id();
+	out += quote;
+	out += "}}";
+	return {session->keys.id(), sequence};
+}
+
+bool CipherSession::openResponse(std::string_view mapJson, const RequestTag &request, std::string &out)
+{
+	SessionEntrySax entry(walletShare_);
+	if (!nlohmann::json::sax_parse(mapJson.begin(), mapJson.end(), &entry, nlohmann::json::input_format_t::json, true))
+	{
+		throw std::invalid_argument("Malformed ML-KEM768 envelope map");
+	}
+	if (!entry.found)
+	{
+		return false;
+	}
+	if (!entry.session)
+	{
+		if (!request.session.empty())
+		{
+			throw std::runtime_error("CipherHash session: single-shot response to a session request");
+		}
+		return wallet_->openStringML768(mapJson, out);
+	}
+	if (!entry.sequence)
+	{
+		throw std::runtime_error("CipherHash session: response without a sequence number");
+	}
+	if (*entry.session != request.session || *entry.sequence != request.sequence)
+	{
+		throw std::runtime_error("CipherHash session: response does not answer this request");
+	}
+
+	std::shared_ptr<Session> session;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const auto &candidate : {current_, previous_})
+		{
+			if (candidate && candidate->keys.id() == request.session)
+			{
+				session = candidate;
+				break;
+			}
+		}
+	}
+	if (!session)
+	{
+		throw std::runtime_error("CipherHash session: response to an expired session");
+	}
+
+	session->keys.open(Keys::Direction::Response, *entry.sequence, entry.encryptedMessage, out);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	session->established = true;
+	return true;
+}
+
+void CipherSession::invalidate(const RequestTag &request)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (current_ && current_->keys.id() == request.session)
+	{
+		current_->invalidated = true;
+	}
+}
+
+size_t CipherSession::sessionsOpened() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return opened_;
+}
+
+} // namespace KnishIO
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace KnishIO {
+
+class Wallet;
+
+/**
+ * ML-KEM768 session keys for the CipherHash transport (opt-in)
+ *
+ * The single-shot envelope (Wallet::sealStringML768) runs an ML-KEM768
+ * encapsulation for every request and a decapsulation for every response. A
+ * session runs one encapsulation against the validator's key and derives a
+ * fresh AES-256-GCM key and nonce for every message from its shared secret:
+ *
+ *   root        = HKDF-SHA256(shared secret, salt = session id, info = "KnishIO CipherHash session v1")
+ *   key ‖ nonce = HKDF-Expand-SHA256(root, info = "request" or "response" ‖ u64 big-endian sequence)
+ *
+ * Envelope map entries; the plaintext is the message itself, not JSON-encoded:
+ *
+ *   request,  under hashShare(validator key): {"cipherText", "encryptedMessage", "sequence", "session"}
+ *   response, under hashShare(wallet key):    {"encryptedMessage", "sequence", "session"}
+ *
+ * encryptedMessage is base64 of nonce ‖ ciphertext ‖ tag, as in the
+ * single-shot envelope. Requests carry cipherText until a response in their
+ * session has been opened, so a lost first request never strands the
+ * session; a session the validator no longer holds is invalidated, and the
+ * next request opens a new one. Every request (and every retry) takes a new
+ * sequence number, so no key or nonce is used twice, and a response only
+ * opens for the request with its session and sequence. The validator must
+ * support session envelopes: a single-shot response to a session request is
+ * refused.
+ */
+class CipherSession
+{
+public:
+	struct Options
+	{
+		size_t						maxRequests = 1024;		// requests per session before a new encapsulation
+		std::chrono::seconds		maxAge{600};			// session lifetime
+	};
+
+	// Session and sequence a request was sealed under; its response must carry the same pair
+	struct RequestTag
+	{
+		std::string		session;
+		uint64_t		sequence = 0;
+	};
+
+	/**
+	 * class CipherSession::Keys
+	 *
+	 * Key schedule of one session; the validator side derives the same keys
+	 * from the decapsulated shared secret.
+	 */
+	class Keys
+	{
+	public:
+		enum class Direction { Request, Response };
+
+		Keys(std::string id, std::span<const uint8_t, 32> sharedSecret);
+		~Keys();
+
+		Keys(const Keys &) = delete;
+		Keys &operator=(const Keys &) = delete;
+
+		const std::string &id() const { return id_; }
+
+		// Appends base64(nonce ‖ ciphertext ‖ tag) of the message to out
+		void seal(Direction direction, uint64_t sequence, std::string_view message, std::string &out) const;
+		// Replaces out with the plaintext; throws std::runtime_error when the message does not authenticate
+		void open(Direction direction, uint64_t sequence, std::string_view sealed, std::string &out) const;
+
+	private:
+		std::string	id_;
+		uint8_t		root_[32];
+	};
+
+	// Requests are encrypted to serverPubKey (base64), responses are addressed to the wallet
+	CipherSession(std::shared_ptr<Wallet> wallet, std::string serverPubKey, Options options);
+	CipherSession(std::shared_ptr<Wallet> wallet, std::string serverPubKey);
+	~CipherSession();
+
+	CipherSession(const CipherSession &) = delete;
+	CipherSession &operator=(const CipherSession &) = delete;
+
+	// Appends the request envelope map to out, its quotes escaped when it goes inside a JSON string
+	RequestTag sealRequest(std::string_view message, std::string &out, bool escaped = false);
+	// Decrypts the response entry addressed to the wallet into out; false when the map holds none.
+	// Throws std::runtime_error when the entry answers anything but request (another request's
+	// response swapped or replayed in, or a single-shot entry, which anyone holding the wallet's
+	// public key can build). Only a request without a session accepts a single-shot entry.
+	bool openResponse(std::string_view mapJson, const RequestTag &request, std::string &out);
+	// Retires the session request was sealed under, e.g. when its response came back without an
+	// entry for the wallet because the validator lost the session; the next request opens a new one
+	void invalidate(const RequestTag &request);
+
+	// Sessions opened so far, one ML-KEM768 encapsulation each
+	size_t sessionsOpened() const;
+
+private:
+	struct Session;
+
+	// Replaces the current session; called with mutex_ held
+	void rotate();
+
+	std::shared_ptr<Wallet>		wallet_;
+	std::string					serverPubKey_;
+	std::string					serverShare_;
+	std::string					walletShare_;
+	Options						options_;
+
+	mutable std::mutex			mutex_;
+	std::shared_ptr<Session>	current_;
+	std::shared_ptr<Session>	previous_;		// still answers requests sent before the rotation
+	size_t						opened_ = 0;
+};
+
+} // namespace KnishIO
@@ -1,9 +1,12 @@
 #include "KnishIOClient.h"
 #include "Wallet.h"
 #include "Molecule.h"
+#include "WalletCache.h"
+#include "ChainPipeline.h"
 #include "utility.h"
 #include "exception/KnishIOException.h"
 #include "http/GraphQLClient.h"
+#include "http/NodeSelector.h"
 #include "response/Response.h"
 #include <iostream>
 #include <sstream>
@@ -18,10 +21,21 @@ namespace knishio {
 using KnishIO::Wallet;
 using KnishIO::Molecule;
 using KnishIO::Atom;
+using KnishIO::WalletCache;
 
 // Version information
 constexpr const char* SDK_VERSION = "0.9.2";
 
+namespace {
+
+// Why a request got no usable response: the transport's error when it has one (a lost
+// connection, an encrypted response that didn't open), otherwise the HTTP status
+std::string failureReason(const http::GraphQLClient::Response& response) {
+    return response.error.value_or("HTTP " + std::to_string(response.statusCode));
+}
+
+} // anonymous namespace
+
 // Forward declare implementation class
 class KnishIOClient::Impl {
 public:
@@ -29,23 +43,148 @@ public:
     std::optional<std::string> secret;
     std::optional<std::string> bundle;
     std::unique_ptr<Wallet> authWallet;
-    std::unique_ptr<http::GraphQLClient> httpClient;
+    std::unique_ptr<http::NodeSelector> nodes;
+    std::optional<size_t> cipherNode;  // node whose ML-KEM key the session's cipher context uses
     std::optional<std::string> authToken;
-    mutable std::mt19937 rng{std::random_device{}()};
+    std::unique_ptr<WalletCache> walletCache;
 
     explicit Impl(const Config& cfg) 
         : config(cfg) {
-        // Initialize HTTP client with first URI
+        if (config.walletCacheSize > 0) {
+            walletCache = std::make_unique<WalletCache>(config.walletCacheSize);
+        }
+
+        // One HTTP client per node; requests are routed by latency, load and health
         if (!config.uris.empty()) {
-            httpClient = std::make_unique<http::GraphQLClient>(
-                config.uris[0],
+            nodes = std::make_unique<http::NodeSelector>(
+                config.uris,
                 config.timeout.count(),
                 config.maxRetries
             );
-            if (config.insecureTls) {
-                httpClient->setVerifySSL(false);
-            }
+            nodes->forEachClient([this](http::GraphQLClient& client) {
+                if (config.insecureTls) {
+                    client.setVerifySSL(false);
+                }
+                if (config.sharedSession) {
+                    client.setSharedSession(true);
+                }
+                if (config.cipherSessionRequests > 0) {
+                    client.setCipherSession(config.cipherSessionRequests, config.cipherSessionLifetime);
+                }
+            });
+        }
+    }
+
+    // Proposes already-signed ProposeMolecule variables
+    std::unique_ptr<response::ResponseProposeMolecule> propose(nlohmann::json variables) {
+        static const auto PROPOSE_MOLECULE = http::GraphQLClient::Request::prepare(
+            "mutation ProposeMolecule($molecule: MoleculeInput!) {"
+            " ProposeMolecule(molecule: $molecule) {"
+            " molecularHash status reason payload createdAt } }");
+
+        // A U-isotope molecule is an authorization request, which travels outside CipherHash
+        const auto& atoms = variables.at("molecule").at("atoms");
+        bool uIsotope = !atoms.empty() && atoms[0].value("isotope", std::string{}) == "U";
+
+        auto httpResp = execute(PROPOSE_MOLECULE, std::move(variables), uIsotope);
+
+        auto result = std::make_unique<response::ResponseProposeMolecule>();
+        if (!httpResp.isSuccess()) {
+            result->setError("Molecule proposal failed (" + failureReason(httpResp) + ")");
+            return result;
         }
+        if (!result->parseBody(httpResp.body)) {
+            result->setError("Molecule proposal returned malformed JSON");
+        }
+        http::GraphQLClient::recycle(std::move(httpResp));
+        return result;
+    }
+
+    // Builds the pure 3-V value molecule of one transfer: the source wallet at @p sourcePosition is
+    // debited its full @p sourceBalance, the recipient receives @p amount and a same-token
+    // remainder at @p remainderPosition (empty = fresh random) holds the change.
+    Molecule buildTransfer(const std::string& sec,
+                           const std::string& token,
+                           const std::string& sourcePosition,
+                           const std::string& sourceBalance,
+                           const std::vector<KnishIO::TokenUnit>& sourceUnits,
+                           const std::string& bundleHash,
+                           long long amount,
+                           const std::string& batchId,
+                           const std::vector<std::string>& units,
+                           const std::string& remainderPosition) const {
+        Wallet source = sourceWallet(sec, token, sourcePosition);  // re-derives the registered address from secret+token+position
+        source.balance = sourceBalance;           // initValue debits the full balance (UTXO pattern)
+        source.tokenUnits = sourceUnits;          // stackable units from the Balance response (forward-compat)
+
+        // RECIPIENT: a shadow wallet for the recipient bundle (we have no secret for it -> no
+        // position/address; identified by bundle + token + batchId). The validator's recipient
+        // path keys off metaId(=bundle) + batchId; the empty address/position are ignored on the
+        // shadow branch, and a fresh recipient REQUIRES the batchId.
+        Wallet recipient(sec, token);
+        recipient.bundle = bundleHash;
+        recipient.address = "";
+        recipient.position = "";
+        recipient.batchId = batchId;   // -> recipient V-atom batchId; validator creates a claimable shadow
+
+        // REMAINDER: a same-token wallet (new position) holding (balance - amount); the validator
+        // registers it, advancing the sender's chain.
+        Wallet remainder = remainderWallet(sec, token, remainderPosition);
+
+        // Stackable (NFT) transfer: partition the source's tokenUnits → source + recipient get the
+        // SENT units, remainder gets the KEPT units. No-op for fungible (units empty). Must run
+        // before initValue reads the wallets' units. (A live source carries units only once
+        // tokenUnits response-parsing lands — follow-up; offline drivers set units directly.)
+        if (!units.empty()) {
+            source.splitUnits(units, remainder, &recipient);
+        }
+
+        // Pure 3-V value molecule (NO ContinuID I-atom — the sender is non-genesis, having funded
+        // the token). initValue: V0 source -balance, V1 recipient +amount, V2 remainder +change.
+        Molecule mol(config.cellSlug.value_or(std::string{}));
+        mol.sourceWallet = std::make_shared<Wallet>(source);
+        mol.remainderWallet = std::make_shared<Wallet>(remainder);
+        mol.initValue(source, recipient, remainder, std::to_string(amount));
+        return mol;
+    }
+
+    // Encrypted traffic can only go to the node holding the cipher context
+    void applyEncryption(bool encrypt) {
+        nodes->forEachClient([encrypt](http::GraphQLClient& client) {
+            client.setEncryption(encrypt);
+        });
+        nodes->setAffinity(encrypt ? cipherNode : std::nullopt);
+    }
+
+    // Sends a prepared request (classified once, see Request::prepare) with this call's variables
+    http::GraphQLClient::Response execute(const http::GraphQLClient::Request& prepared, nlohmann::json variables,
+                                          bool uIsotope = false) {
+        http::GraphQLClient::Request request = prepared;
+        request.variables = std::move(variables);
+        request.operation->uIsotope = uIsotope;
+        auto lease = nodes->acquire();
+        auto response = lease.client().execute(std::move(request)).get();
+        lease.complete(response);
+        return response;
+    }
+
+    // The derivation cache (when configured) only holds positions that are derived twice: a
+    // remainder's position is the source of its chain's next molecule. Remainders are recorded
+    // (an empty position is drawn fresh by the Wallet constructor and recorded under it) and a
+    // source takes its entry back out, since a one-time-signature chain never signs there again.
+    // Recipient, burn, buffer, new-token and auth wallets bypass the cache.
+    Wallet remainderWallet(const std::string& sec, const std::string& token, const std::string& position = {}) const {
+        if (walletCache) {
+            return Wallet(sec, token, position, *walletCache, Wallet::CacheUse::Record);
+        }
+        return Wallet(sec, token, position);
+    }
+
+    Wallet sourceWallet(const std::string& sec, const std::string& token, const std::string& position) const {
+        if (walletCache) {
+            return Wallet(sec, token, position, *walletCache, Wallet::CacheUse::Spend);
+        }
+        return Wallet(sec, token, position);
     }
 
     ~Impl() {
@@ -105,6 +244,22 @@ KnishIOClient::Builder& KnishIOClient::Builder::retryDelay(std::chrono::millisec
     return *this;
 }
 
+KnishIOClient::Builder& KnishIOClient::Builder::walletCache(size_t capacity) {
+    config_.walletCacheSize = capacity;
+    return *this;
+}
+
+KnishIOClient::Builder& KnishIOClient::Builder::sharedSession(bool enable) {
+    config_.sharedSession = enable;
+    return *this;
+}
+
+KnishIOClient::Builder& KnishIOClient::Builder::cipherSession(size_t maxRequests, std::chrono::seconds lifetime) {
+    config_.cipherSessionRequests = maxRequests;
+    config_.cipherSessionLifetime = lifetime;
+    return *this;
+}
+
 std::unique_ptr<KnishIOClient> KnishIOClient::Builder::build() const {
     if (config_.uris.empty()) {
         throw KnishIOException("At least one URI must be provided");
@@ -155,6 +310,11 @@ void KnishIOClient::setSecret(const std::string& secret) {
     }
     
     pImpl_->secret = secret;
+
+    // Cached material derived from a previous secret has no further use
+    if (pImpl_->walletCache) {
+        pImpl_->walletCache->clear();
+    }
     
     // Generate wallet from secret
     pImpl_->authWallet = std::make_unique<Wallet>(secret);
@@ -226,10 +386,10 @@ KnishIOClient::queryWallets(const std::optional<std::string>& bundle,
         // Validator: wallets(bundleHash, limit, offset) -> [Wallet]. No server-side token filter;
         // callers filter the returned list by token if needed.
         (void)token;
-        static const std::string WALLETS_QUERY =
+        static const auto WALLETS_QUERY = http::GraphQLClient::Request::prepare(
             "query Wallets($bundleHash: String!, $limit: Int, $offset: Int) {"
             " wallets(bundleHash: $bundleHash, limit: $limit, offset: $offset) {"
-            " address bundleHash tokenSlug position pubkey balance amount batchId } }";
+            " address bundleHash tokenSlug position pubkey balance amount batchId } }");
         nlohmann::json variables;
         variables["bundleHash"] = b;
         variables["limit"] = 100;
@@ -237,13 +397,14 @@ KnishIOClient::queryWallets(const std::optional<std::string>& bundle,
 
         auto result = std::make_unique<response::ResponseWalletList>();
         try {
-            auto httpResp = pImpl_->httpClient->query(WALLETS_QUERY, variables).get();
+            auto httpResp = pImpl_->execute(WALLETS_QUERY, std::move(variables));
             if (httpResp.isSuccess()) {
-                nlohmann::json body = nlohmann::json::parse(httpResp.body);
-                result->setData(body.contains("data") && !body["data"].is_null() ? body["data"] : body);
-                result->parseData();
+                if (!result->parseBody(httpResp.body)) {
+                    result->setError("Wallets query returned malformed JSON");
+                }
+                http::GraphQLClient::recycle(std::move(httpResp));
             } else {
-                result->setError("Wallets query failed (HTTP " + std::to_string(httpResp.statusCode) + ")");
+                result->setError("Wallets query failed (" + failureReason(httpResp) + ")");
             }
         } catch (const std::exception& e) {
             result->setError(std::string("Wallets query error: ") + e.what());
@@ -256,10 +417,10 @@ std::future<std::unique_ptr<response::ResponseContinuId>>
 KnishIOClient::queryContinuId(const std::string& bundle) {
     return std::async(std::launch::async, [this, bundle]() -> std::unique_ptr<response::ResponseContinuId> {
         // ContinuId queries don't require authentication (PUBLIC on the validator).
-        static const std::string CONTINUID_QUERY =
+        static const auto CONTINUID_QUERY = http::GraphQLClient::Request::prepare(
             "query ContinuId($bundle: String, $token: String) {"
             " ContinuId(bundle: $bundle, token: $token) {"
-            " position address tokenSlug bundleHash pubkey characters } }";
+            " position address tokenSlug bundleHash pubkey characters } }");
         nlohmann::json variables;
         variables["bundle"] = bundle;
         variables["token"] = "USER";
@@ -267,13 +428,14 @@ KnishIOClient::queryContinuId(const std::string& bundle) {
 
         auto result = std::make_unique<response::ResponseContinuId>();
         try {
-            auto httpResp = pImpl_->httpClient->query(CONTINUID_QUERY, variables).get();
+            auto httpResp = pImpl_->execute(CONTINUID_QUERY, std::move(variables));
             if (httpResp.isSuccess()) {
-                nlohmann::json body = nlohmann::json::parse(httpResp.body);
-                result->setData(body.contains("data") && !body["data"].is_null() ? body["data"] : body);
-                result->parseData();
+                if (!result->parseBody(httpResp.body)) {
+                    result->setError("ContinuId query returned malformed JSON");
+                }
+                http::GraphQLClient::recycle(std::move(httpResp));
             } else {
-                result->setError("ContinuId query failed (HTTP " + std::to_string(httpResp.statusCode) + ")");
+                result->setError("ContinuId query failed (" + failureReason(httpResp) + ")");
             }
         } catch (const std::exception& e) {
             result->setError(std::string("ContinuId query error: ") + e.what());
@@ -318,8 +480,24 @@ Molecule* KnishIOClient::createMolecule(
     return molecule;
 }
 
+namespace {
+
+// Signs + verifies a molecule and serializes it into ProposeMolecule variables, without the
+// validation-context wallets the validator's MoleculeInput rejects.
+nlohmann::json signedProposal(Molecule& mol, const std::string& secret) {
+    mol.sign(secret);
+    if (!Molecule::verify(mol)) {
+        throw KnishIOException("Molecule validation failed");
+    }
+
+    nlohmann::json variables;
+    variables["molecule"] = mol.toJsonValue(false);
+    return variables;
+}
+
+} // anonymous namespace
+
 // Sign + submit a molecule via ProposeMolecule (sync; reused by proposeMolecule + the token ops).
-// Serializes + strips the validation-context wallets the validator's MoleculeInput rejects.
 std::unique_ptr<response::ResponseProposeMolecule>
 KnishIOClient::submitMolecule(KnishIO::Molecule& mol) {
     if (!hasSecret()) {
@@ -327,60 +505,31 @@ KnishIOClient::submitMolecule(KnishIO::Molecule& mol) {
     }
 
     // NOLINTNEXTLINE(bugprone-unchecked-optional-access) — guarded by hasSecret() above
-    mol.sign(pImpl_->secret.value());
-    if (!Molecule::verify(mol)) {
-        throw KnishIOException("Molecule validation failed");
-    }
-
-    nlohmann::json moleculeJson = nlohmann::json::parse(mol.toJson());
-    moleculeJson.erase("sourceWallet");
-    moleculeJson.erase("remainderWallet");
-
-    static const std::string PROPOSE_MOLECULE =
-        "mutation ProposeMolecule($molecule: MoleculeInput!) {"
-        " ProposeMolecule(molecule: $molecule) {"
-        " molecularHash status reason payload createdAt } }";
-    nlohmann::json variables;
-    variables["molecule"] = moleculeJson;
+    nlohmann::json variables = signedProposal(mol, pImpl_->secret.value());
 
     log("INFO", "Proposing molecule with hash: " + mol.molecularHash);
 
-    auto httpResp = pImpl_->httpClient->mutate(PROPOSE_MOLECULE, variables).get();
-
-    auto result = std::make_unique<response::ResponseProposeMolecule>();
-    if (!httpResp.isSuccess()) {
-        result->setError("Molecule proposal failed (HTTP " + std::to_string(httpResp.statusCode) + ")");
-        return result;
-    }
-    nlohmann::json body = nlohmann::json::parse(httpResp.body);
-    result->setData(body.contains("data") && !body["data"].is_null() ? body["data"] : body);
-    return result;
+    return pImpl_->propose(std::move(variables));
 }
 
 // Resolve a bundle's live on-ledger ContinuID position (the chain head a non-U molecule must sign
 // at). Queries the PUBLIC ContinuId(bundle, "USER"); returns the 64-char position, or "" for a
 // genesis bundle (no ContinuID yet -> the caller falls back to a fresh random position).
 std::string KnishIOClient::resolveContinuIdPosition(const std::string& bundle) {
-    static const std::string CONTINUID_QUERY =
+    static const auto CONTINUID_QUERY = http::GraphQLClient::Request::prepare(
         "query ContinuId($bundle: String, $token: String) {"
         " ContinuId(bundle: $bundle, token: $token) {"
-        " position address tokenSlug bundleHash pubkey characters } }";
+        " position address tokenSlug bundleHash pubkey characters } }");
     nlohmann::json variables;
     variables["bundle"] = bundle;
     variables["token"] = "USER";
     try {
-        auto httpResp = pImpl_->httpClient->query(CONTINUID_QUERY, variables).get();
-        if (httpResp.isSuccess()) {
-            nlohmann::json body = nlohmann::json::parse(httpResp.body);
-            if (body.contains("data") && body["data"].contains("ContinuId")
-                && body["data"]["ContinuId"].is_object()) {
-                const auto& cid = body["data"]["ContinuId"];
-                if (cid.contains("position") && cid["position"].is_string()) {
-                    std::string pos = cid["position"].get<std::string>();
-                    if (pos.size() == 64) {
-                        return pos;
-                    }
-                }
+        auto httpResp = pImpl_->execute(CONTINUID_QUERY, std::move(variables));
+        response::ResponseContinuId cid;
+        if (httpResp.isSuccess() && cid.parseBody(httpResp.body)) {
+            auto continuId = cid.getContinuId();
+            if (continuId && continuId->position.size() == 64) {
+                return continuId->position;
             }
         }
     } catch (const std::exception&) {
@@ -396,58 +545,29 @@ std::string KnishIOClient::resolveContinuIdPosition(const std::string& bundle) {
 // The position/balance MUST come from the validator: createToken registered the token wallet at a
 // random position (not recoverable client-side), and the V-isotope signer must sign at that
 // registered position.
-// Parse a wallet GraphQL object's `tokenUnits` array into TokenUnit values (canonical
-// { id, name, metas }). Forward-compat: the validator's tokenUnits resolver is a stub returning
-// [] until gap SDK-001 lands, so this yields units only when the response carries them.
-std::vector<KnishIO::TokenUnit> parseWalletTokenUnits(const nlohmann::json& walletObj) {
-    std::vector<KnishIO::TokenUnit> out;
-    if (walletObj.contains("tokenUnits") && walletObj["tokenUnits"].is_array()) {
-        for (const auto& u : walletObj["tokenUnits"]) {
-            KnishIO::TokenUnit tu;
-            if (u.contains("id") && u["id"].is_string()) tu.id = u["id"].get<std::string>();
-            if (u.contains("name") && u["name"].is_string()) tu.name = u["name"].get<std::string>();
-            if (u.contains("metas") && u["metas"].is_object()) {
-                for (auto it = u["metas"].begin(); it != u["metas"].end(); ++it) {
-                    if (it.value().is_string()) tu.metas[it.key()] = it.value().get<std::string>();
-                }
-            }
-            out.push_back(std::move(tu));
-        }
-    }
-    return out;
-}
-
 KnishIOClient::TokenWalletInfo
 KnishIOClient::resolveTokenWallet(const std::string& bundle, const std::string& token) {
-    static const std::string BALANCE_QUERY =
+    static const auto BALANCE_QUERY = http::GraphQLClient::Request::prepare(
         "query($bundleHash: String, $token: String) {"
         " Balance(bundleHash: $bundleHash, token: $token) {"
         " position address tokenSlug amount pubkey batchId bundleHash"
-        " tokenUnits { id name metas } } }";
+        " tokenUnits { id name metas } } }");
     nlohmann::json variables;
     variables["bundleHash"] = bundle;
     variables["token"] = token;
 
     TokenWalletInfo info;
     try {
-        auto httpResp = pImpl_->httpClient->query(BALANCE_QUERY, variables).get();
-        if (httpResp.isSuccess()) {
-            nlohmann::json body = nlohmann::json::parse(httpResp.body);
-            if (body.contains("data") && body["data"].contains("Balance")
-                && body["data"]["Balance"].is_object()) {
-                const auto& bal = body["data"]["Balance"];
-                if (bal.contains("position") && bal["position"].is_string()) {
-                    info.position = bal["position"].get<std::string>();
-                }
-                if (bal.contains("address") && bal["address"].is_string()) {
-                    info.address = bal["address"].get<std::string>();
-                }
-                if (bal.contains("amount") && bal["amount"].is_string()) {
-                    info.balance = bal["amount"].get<std::string>();
-                }
+        auto httpResp = pImpl_->execute(BALANCE_QUERY, std::move(variables));
+        response::ResponseBalance balance;
+        if (httpResp.isSuccess() && balance.parseBody(httpResp.body)) {
+            if (auto bal = balance.getBalance()) {
+                info.position = std::move(bal->position);
+                info.address = std::move(bal->address);
+                info.balance = std::move(bal->amount);
                 // A spendable (non-shadow) source must have a real position + address.
                 info.found = !info.position.empty() && !info.address.empty();
-                info.tokenUnits = parseWalletTokenUnits(bal);  // stackable units (forward-compat)
+                info.tokenUnits = std::move(bal->tokenUnits);  // stackable units (forward-compat)
             }
         }
     } catch (const std::exception&) {
@@ -481,9 +601,9 @@ KnishIOClient::createToken(const std::string& token,
         // remainder is a fresh chain head (the relay race).
         const std::string bundle = getBundle();
         const std::string livePos = resolveContinuIdPosition(bundle);
-        Wallet source(sec, "USER", livePos);   // livePos == "" -> fresh random (genesis)
+        Wallet source = pImpl_->sourceWallet(sec, "USER", livePos);   // livePos == "" -> fresh random (genesis)
         Wallet recipient(sec, token);          // new-token wallet, fresh random position
-        Wallet remainder(sec, "USER");         // fresh random remainder
+        Wallet remainder = pImpl_->remainderWallet(sec, "USER");    // fresh random remainder
 
         std::vector<std::pair<std::string, std::string>> tokenMeta;
         tokenMeta.reserve(meta.size() + 3);
@@ -536,9 +656,9 @@ KnishIOClient::createWallet(const std::string& token) {
         const std::string sec = pImpl_->secret.value();
 
         const std::string livePos = resolveContinuIdPosition(getBundle());
-        Wallet source(sec, "USER", livePos);   // sign at the live ContinuID position
+        Wallet source = pImpl_->sourceWallet(sec, "USER", livePos);   // sign at the live ContinuID position
         Wallet newWallet(sec, token);          // the wallet being defined (fresh position)
-        Wallet remainder(sec, "USER");         // fresh remainder (relay race)
+        Wallet remainder = pImpl_->remainderWallet(sec, "USER");    // fresh remainder (relay race)
 
         Molecule mol(pImpl_->config.cellSlug.value_or(std::string{}));
         mol.sourceWallet = std::make_shared<Wallet>(source);
@@ -557,10 +677,10 @@ KnishIOClient::claimShadowWallet(const std::string& token, const std::string& ba
         const std::string sec = pImpl_->secret.value();
 
         const std::string livePos = resolveContinuIdPosition(getBundle());
-        Wallet source(sec, "USER", livePos);   // sign at the live ContinuID position
+        Wallet source = pImpl_->sourceWallet(sec, "USER", livePos);   // sign at the live ContinuID position
         Wallet claimWallet(sec, token);        // the shadow wallet being claimed
         claimWallet.batchId = batchId;         // -> walletBatchId meta (validator matches by it)
-        Wallet remainder(sec, "USER");         // fresh remainder
+        Wallet remainder = pImpl_->remainderWallet(sec, "USER");    // fresh remainder
 
         Molecule mol(pImpl_->config.cellSlug.value_or(std::string{}));
         mol.sourceWallet = std::make_shared<Wallet>(source);
@@ -597,38 +717,9 @@ KnishIOClient::transferToken(const std::string& bundleHash,
             throw KnishIOException("Insufficient balance for token " + token);
         }
 
-        Wallet source(sec, token, src.position);  // re-derives the registered address from secret+token+position
-        source.balance = src.balance;             // initValue debits the full balance (UTXO pattern)
-        source.tokenUnits = src.tokenUnits;       // stackable units from the Balance response (forward-compat)
-
-        // 2. RECIPIENT: a shadow wallet for the recipient bundle (we have no secret for it -> no
-        //    position/address; identified by bundle + token + batchId). The validator's recipient
-        //    path keys off metaId(=bundle) + batchId; the empty address/position are ignored on the
-        //    shadow branch, and a fresh recipient REQUIRES the batchId.
-        Wallet recipient(sec, token);
-        recipient.bundle = bundleHash;
-        recipient.address = "";
-        recipient.position = "";
-        recipient.batchId = batchId;   // -> recipient V-atom batchId; validator creates a claimable shadow
-
-        // 3. REMAINDER: a fresh same-token wallet (new position) holding (balance - amount); the
-        //    validator registers it, advancing the sender's chain.
-        Wallet remainder(sec, token);
-
-        // Stackable (NFT) transfer: partition the source's tokenUnits → source + recipient get the
-        // SENT units, remainder gets the KEPT units. No-op for fungible (units empty). Must run
-        // before initValue reads the wallets' units. (A live source carries units only once
-        // tokenUnits response-parsing lands — follow-up; offline drivers set units directly.)
-        if (!units.empty()) {
-            source.splitUnits(units, remainder, &recipient);
-        }
-
-        // 4. Pure 3-V value molecule (NO ContinuID I-atom — the sender is non-genesis, having funded
-        //    the token). initValue: V0 source -balance, V1 recipient +amount, V2 remainder +change.
-        Molecule mol(pImpl_->config.cellSlug.value_or(std::string{}));
-        mol.sourceWallet = std::make_shared<Wallet>(source);
-        mol.remainderWallet = std::make_shared<Wallet>(remainder);
-        mol.initValue(source, recipient, remainder, std::to_string(amountLL));
+        // 2. Recipient shadow wallet + fresh remainder; 3. pure 3-V value molecule.
+        Molecule mol = pImpl_->buildTransfer(sec, token, src.position, src.balance, src.tokenUnits,
+                                             bundleHash, amountLL, batchId, units, std::string{});
 
         log("INFO", "Transferring " + std::to_string(amountLL) + " " + token + " to " + bundleHash);
         return submitMolecule(mol);
@@ -671,7 +762,7 @@ KnishIOClient::transferTokens(const std::string& token,
         if (srcBalance < total) {
             throw KnishIOException("Insufficient balance for token " + token);
         }
-        Wallet source(sec, token, src.position);  // re-derives the registered address
+        Wallet source = pImpl_->sourceWallet(sec, token, src.position);  // re-derives the registered address
         source.balance = src.balance;             // initValues debits the full balance (UTXO)
         source.tokenUnits = src.tokenUnits;
 
@@ -688,7 +779,7 @@ KnishIOClient::transferTokens(const std::string& token,
         }
 
         // 3. REMAINDER: a fresh same-token wallet (new position) holding (balance - total)
-        Wallet remainder(sec, token);
+        Wallet remainder = pImpl_->remainderWallet(sec, token);
 
         // 4. Stackable (NFT): partition the source's units → source keeps the SENT union, each
         //    recipient its subset, remainder the KEPT. No-op for fungible. Must run before initValues.
@@ -714,6 +805,163 @@ KnishIOClient::transferTokens(const std::string& token,
     });
 }
 
+bool KnishIOClient::BatchTransferResult::accepted() const {
+    return !error.has_value() && response && response->isAccepted();
+}
+
+std::future<std::vector<KnishIOClient::BatchTransferResult>>
+KnishIOClient::transferTokenBatch(const std::vector<BatchTransfer>& transfers) {
+    return transferTokenBatch(transfers, BatchTransferOptions{});
+}
+
+std::future<std::vector<KnishIOClient::BatchTransferResult>>
+KnishIOClient::transferTokenBatch(const std::vector<BatchTransfer>& transfers,
+                                  const BatchTransferOptions& options) {
+    return std::async(std::launch::async, [this, transfers, options]() -> std::vector<BatchTransferResult> {
+        ensureAuthenticated();
+        const std::string sec = pImpl_->secret.value();
+        const std::string senderBundle = getBundle();
+
+        std::vector<BatchTransferResult> results(transfers.size());
+        std::mutex resultMutex;  // serializes onResult across concurrently submitting tokens
+        auto settle = [&](size_t index, std::optional<std::string> error) {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            results[index].error = std::move(error);
+            if (options.onResult) {
+                options.onResult(index, results[index]);
+            }
+        };
+
+        // One link of a token's chain: spends sourcePosition, leaves the change at remainderPosition
+        struct Link {
+            size_t index;
+            std::string sourcePosition;
+            std::string sourceBalance;
+            std::string remainderPosition;
+            long long amount;
+            nlohmann::json proposal;  // signed ProposeMolecule variables, released once proposed
+            bool accepted = false;
+        };
+        std::vector<Link> links;
+        std::vector<std::vector<size_t>> chains;
+
+        std::vector<std::string> tokens;
+        std::unordered_map<std::string, std::vector<size_t>> itemsByToken;
+        for (size_t index = 0; index < transfers.size(); index++) {
+            auto& items = itemsByToken[transfers[index].token];
+            if (items.empty()) {
+                tokens.push_back(transfers[index].token);
+            }
+            items.push_back(index);
+        }
+
+        // Resolve each token's source once and lay out its chain of remainders
+        for (const auto& token : tokens) {
+            const auto& items = itemsByToken[token];
+            TokenWalletInfo src = resolveTokenWallet(senderBundle, token);
+            if (!src.found || !src.tokenUnits.empty()) {
+                std::string error = src.found
+                    ? "Batch transfers support fungible tokens only: " + token
+                    : "No spendable wallet for token " + token;
+                for (size_t index : items) {
+                    settle(index, error);
+                }
+                continue;
+            }
+
+            long long balance = 0;
+            try { balance = std::stoll(src.balance); } catch (const std::exception&) { balance = 0; }
+            std::string position = src.position;
+            std::vector<size_t> chain;
+            for (size_t index : items) {
+                const long long amount = static_cast<long long>(transfers[index].amount);
+                if (balance < amount) {
+                    settle(index, "Insufficient balance for token " + token);
+                    continue;
+                }
+                std::string remainderPosition = randomString(64, "abcdef0123456789");
+                chain.push_back(links.size());
+                links.push_back({index, position, std::to_string(balance), remainderPosition, amount, {}});
+                balance -= amount;
+                position = std::move(remainderPosition);
+            }
+            chains.push_back(std::move(chain));
+        }
+
+        log("INFO", "Batch transfer: " + std::to_string(links.size()) + " molecules across " +
+                    std::to_string(chains.size()) + " token chain(s)");
+
+        ChainPipeline::Options pipelineOptions;
+        pipelineOptions.workers = options.signingThreads;
+        pipelineOptions.window = options.signAhead;
+        pipelineOptions.maxChains = options.concurrentTokens;
+
+        ChainPipeline(pipelineOptions).run(
+            chains,
+            // Build + sign + verify on a worker (CPU)
+            [&](size_t job) {
+                Link& link = links[job];
+                const BatchTransfer& transfer = transfers[link.index];
+                try {
+                    Molecule mol = pImpl_->buildTransfer(sec, transfer.token, link.sourcePosition, link.sourceBalance,
+                                                         {}, transfer.bundleHash, link.amount, transfer.batchId,
+                                                         {}, link.remainderPosition);
+                    link.proposal = signedProposal(mol, sec);
+                    return true;
+                } catch (const std::exception& e) {
+                    settle(link.index, std::string(e.what()));
+                    return false;
+                }
+            },
+            // Propose in chain order (network)
+            [&](size_t job) {
+                Link& link = links[job];
+                nlohmann::json proposal = std::move(link.proposal);
+                link.proposal = nullptr;
+                try {
+                    auto response = pImpl_->propose(std::move(proposal));
+                    bool accepted = response->isAccepted();
+                    std::optional<std::string> error;
+                    if (!accepted) {
+                        std::string reason = response->getRejectionReason();
+                        error = !reason.empty() ? reason
+                              : response->getError().value_or("Molecule was not accepted");
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(resultMutex);
+                        results[link.index].response = std::move(response);
+                    }
+                    link.accepted = accepted;
+                    settle(link.index, std::move(error));
+                    return accepted;
+                } catch (const std::exception& e) {
+                    settle(link.index, std::string(e.what()));
+                    return false;
+                }
+            },
+            // The source of a cancelled link was never registered
+            [&](size_t job) {
+                settle(links[job].index, std::string("Not submitted: an earlier transfer of this token was not accepted"));
+            });
+
+        // Links are signed out of order, so a remainder may be recorded after the next link
+        // already derived its position, or belong to a link that failed or was cancelled. Only
+        // the last accepted remainder of each chain is the source of a later transfer.
+        if (pImpl_->walletCache) {
+            for (const auto& chain : chains) {
+                auto last = std::find_if(chain.rbegin(), chain.rend(), [&](size_t job) { return links[job].accepted; });
+                for (size_t job : chain) {
+                    if (last == chain.rend() || job != *last) {
+                        pImpl_->walletCache->erase(senderBundle, transfers[links[job].index].token, links[job].remainderPosition);
+                    }
+                }
+            }
+        }
+
+        return results;
+    });
+}
+
 std::future<std::unique_ptr<response::ResponseProposeMolecule>>
 KnishIOClient::burnToken(const std::string& token, double amount, const std::vector<std::string>& units) {
     return std::async(std::launch::async, [this, token, amount, units]() -> std::unique_ptr<response::ResponseProposeMolecule> {
@@ -734,7 +982,7 @@ KnishIOClient::burnToken(const std::string& token, double amount, const std::vec
             throw KnishIOException("Insufficient balance for token " + token);
         }
 
-        Wallet source(sec, token, src.position);  // re-derives the registered address from secret+token+position
+        Wallet source = pImpl_->sourceWallet(sec, token, src.position);  // re-derives the registered address from secret+token+position
         source.balance = src.balance;             // initValue debits the full balance (UTXO pattern)
         source.tokenUnits = src.tokenUnits;       // stackable units from the Balance response (forward-compat)
 
@@ -747,7 +995,7 @@ KnishIOClient::burnToken(const std::string& token, double amount, const std::vec
         burnWallet.position = "";
 
         // REMAINDER: a fresh same-token wallet holding (balance - amount).
-        Wallet remainder(sec, token);
+        Wallet remainder = pImpl_->remainderWallet(sec, token);
 
         // Stackable (NFT) burn: partition the source's tokenUnits → source keeps the BURNED units,
         // remainder keeps the rest (no recipient — the units are destroyed). No-op for fungible.
@@ -788,14 +1036,14 @@ KnishIOClient::depositBufferToken(const std::string& token, double amount,
             throw KnishIOException("Insufficient balance for token " + token);
         }
 
-        Wallet source(sec, token, src.position);  // re-derives the registered address
+        Wallet source = pImpl_->sourceWallet(sec, token, src.position);  // re-derives the registered address
         source.balance = src.balance;             // initDepositBuffer debits the full balance (UTXO)
 
         // BUFFER: a FRESH same-token wallet that receives the deposited amount (B-isotope).
         Wallet buffer(sec, token);
 
         // REMAINDER: a FRESH same-token wallet holding (balance - amount).
-        Wallet remainder(sec, token);
+        Wallet remainder = pImpl_->remainderWallet(sec, token);
 
         // V-B-V buffer-deposit molecule (NO ContinuID I-atom).
         Molecule mol(pImpl_->config.cellSlug.value_or(std::string{}));
@@ -827,7 +1075,7 @@ KnishIOClient::withdrawBufferToken(const std::string& token, double amount) {
             throw KnishIOException("Insufficient buffer balance for token " + token);
         }
 
-        Wallet source(sec, token, src.position);  // the buffer wallet (B-isotope source AND remainder)
+        Wallet source = pImpl_->remainderWallet(sec, token, src.position);  // the buffer wallet (B-isotope source AND remainder)
         source.balance = src.balance;             // initWithdrawBuffer debits the full balance (UTXO)
 
         // RECIPIENT: the caller's OWN bundle (JS: recipients = { getBundle(): amount }). Shadow wallet
@@ -875,26 +1123,27 @@ KnishIOClient::requestAuthToken(const std::optional<std::string>& secret,
         mol.initAuthorization(source, encrypt);
         mol.sign(sec);
 
-        // Serialize + strip the validation-context wallets (the validator's MoleculeInput rejects
+        // Serialize without the validation-context wallets (the validator's MoleculeInput rejects
         // unknown sourceWallet/remainderWallet fields — toJson emits them when set).
-        nlohmann::json moleculeJson = nlohmann::json::parse(mol.toJson());
-        moleculeJson.erase("sourceWallet");
-        moleculeJson.erase("remainderWallet");
-
-        static const std::string PROPOSE_MOLECULE =
+        static const auto PROPOSE_MOLECULE = http::GraphQLClient::Request::prepare(
             "mutation ProposeMolecule($molecule: MoleculeInput!) {"
             " ProposeMolecule(molecule: $molecule) {"
-            " molecularHash status reason payload createdAt } }";
-        nlohmann::json variables;
-        variables["molecule"] = moleculeJson;
+            " molecularHash status reason payload createdAt } }");
+        http::GraphQLClient::Request request = PROPOSE_MOLECULE;
+        request.variables = nlohmann::json::object();
+        (*request.variables)["molecule"] = mol.toJsonValue(false);
+        request.operation->uIsotope = true;
 
         log("INFO", "Requesting authorization token (molecular hash: " + mol.molecularHash + ")");
 
-        auto httpResp = pImpl_->httpClient->mutate(PROPOSE_MOLECULE, variables).get();
+        // The lease's node issues the token, and the cipher context below belongs to it
+        auto lease = pImpl_->nodes->acquire();
+        auto httpResp = lease.client().execute(std::move(request)).get();
+        lease.complete(httpResp);
 
         auto result = std::make_unique<response::ResponseRequestAuthorization>();
         if (!httpResp.isSuccess()) {
-            result->setError("Authorization request failed (HTTP " + std::to_string(httpResp.statusCode) + ")");
+            result->setError("Authorization request failed (" + failureReason(httpResp) + ")");
             return result;
         }
 
@@ -911,16 +1160,21 @@ KnishIOClient::requestAuthToken(const std::optional<std::string>& secret,
                     if (payload.contains("token") && payload["token"].is_string()) {
                         const std::string jwt = payload["token"].get<std::string>();
                         pImpl_->authToken = jwt;
-                        pImpl_->httpClient->setAuthToken(jwt);
+                        pImpl_->nodes->forEachClient([&jwt](http::GraphQLClient& client) {
+                            client.setAuthToken(jwt);
+                        });
                     }
                     // PQ-transport Phase E: plumb the validator's advertised ML-KEM pubkey (payload
                     // "key") + the AUTH source wallet (which decrypts CipherHash responses) into the
                     // transport, then set the session encryption flag to match the requested mode.
+                    // The key belongs to the node that issued the token, so an encrypted session
+                    // stays on that node.
                     if (payload.contains("key") && payload["key"].is_string()) {
-                        pImpl_->httpClient->setCipherContext(
+                        pImpl_->nodes->client(lease.node()).setCipherContext(
                             std::make_shared<Wallet>(source), payload["key"].get<std::string>());
+                        pImpl_->cipherNode = lease.node();
                     }
-                    pImpl_->httpClient->setEncryption(encrypt);
+                    pImpl_->applyEncryption(encrypt);
                 } catch (const std::exception&) {
                     // payload not parseable (e.g. a rejected molecule) -> leave authToken unset
                 }
@@ -937,7 +1191,7 @@ bool KnishIOClient::isAuthenticated() const noexcept {
 void KnishIOClient::switchEncryption(bool encrypt) {
     // PQ-transport Phase E: toggle the encrypted transport on the active session. The cipher
     // context (AUTH source wallet + validator pubkey) was plumbed during requestAuthToken.
-    pImpl_->httpClient->setEncryption(encrypt);
+    pImpl_->applyEncryption(encrypt);
 }
 
 // Utility methods
@@ -1003,20 +1257,6 @@ std::string KnishIOClient::getVersion() noexcept {
 }
 
 // Internal helper methods
-std::string KnishIOClient::getRandomUri() const {
-    if (pImpl_->config.uris.empty()) {
-        throw KnishIOException("No URIs available");
-    }
-    
-    if (pImpl_->config.uris.size() == 1) {
-        return pImpl_->config.uris[0];
-    }
-    
-    // Select random URI for load balancing
-    std::uniform_int_distribution<size_t> dist(0, pImpl_->config.uris.size() - 1);
-    return pImpl_->config.uris[dist(pImpl_->rng)];
-}
-
 std::string KnishIOClient::hashSecret(const std::string& secret) const {
     std::vector<unsigned char> hash(32);
     crypto_generichash(hash.data(), hash.size(),
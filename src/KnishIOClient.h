@@ -66,6 +66,10 @@ public:
         std::chrono::milliseconds timeout{30000};         ///< Request timeout
         int maxRetries = 3;                              ///< Maximum retry attempts
         std::chrono::milliseconds retryDelay{1000};      ///< Delay between retries
+        size_t walletCacheSize = 0;                       ///< Derived-wallet LRU entries for remainders the next molecule spends (0 = no cache)
+        bool sharedSession = false;                       ///< Share DNS/TLS session/connection cache with other clients
+        size_t cipherSessionRequests = 0;                 ///< Encrypted requests per ML-KEM session key (0 = one encapsulation per request)
+        std::chrono::seconds cipherSessionLifetime{600};  ///< ML-KEM session key lifetime
     };
 
     /**
@@ -80,6 +84,37 @@ public:
         std::vector<std::string> units;
     };
 
+    /**
+     * One fungible transfer of a batch (see transferTokenBatch)
+     */
+    struct BatchTransfer {
+        std::string bundleHash;                           ///< Recipient's bundle hash
+        std::string token;                                ///< Token slug to transfer
+        double amount = 0.0;                              ///< Amount to transfer
+        std::string batchId;                              ///< Optional shadow-wallet batch id (see transferToken)
+    };
+
+    /**
+     * Outcome of one batch transfer
+     */
+    struct BatchTransferResult {
+        std::unique_ptr<response::ResponseProposeMolecule> response;  ///< Null if never proposed
+        std::optional<std::string> error;                 ///< Why the transfer was not accepted
+
+        [[nodiscard]] bool accepted() const;
+    };
+
+    /**
+     * Tuning for transferTokenBatch
+     */
+    struct BatchTransferOptions {
+        size_t signingThreads = 0;                        ///< Signing workers (0 = hardware concurrency)
+        size_t signAhead = 32;                            ///< Signed-but-unsubmitted molecules per token
+        size_t concurrentTokens = 4;                      ///< Tokens submitting in parallel
+        /// Called as each item settles (on pipeline threads, possibly concurrently for different tokens)
+        std::function<void(size_t index, const BatchTransferResult& result)> onResult;
+    };
+
     /**
      * Builder pattern for creating KnishIOClient instances
      */
@@ -94,6 +129,9 @@ public:
         Builder& timeout(std::chrono::milliseconds timeout);
         Builder& maxRetries(int retries);
         Builder& retryDelay(std::chrono::milliseconds delay);
+        Builder& walletCache(size_t capacity);
+        Builder& sharedSession(bool enable = true);
+        Builder& cipherSession(size_t maxRequests, std::chrono::seconds lifetime = std::chrono::seconds(600));
         
         [[nodiscard]] std::unique_ptr<KnishIOClient> build() const;
         
@@ -250,6 +288,29 @@ public:
     transferTokens(const std::string& token,
                    const std::vector<TransferRecipient>& recipients);
 
+    /**
+     * Pipelined batch of fungible transfers (payout jobs)
+     *
+     * Each token's source wallet is resolved once; its transfers then form a chain in which every
+     * transfer spends the previous one's remainder, so the whole chain can be built and signed
+     * up front on a worker pool while earlier links are still being proposed. Proposals go out in
+     * chain order, one at a time per token (the validator must register a remainder before it can
+     * be spent); different tokens are proposed concurrently. Signing runs at most
+     * options.signAhead molecules ahead of submission per token.
+     *
+     * A transfer that is not accepted stops its token's chain: the later transfers of that token
+     * are reported as not submitted.
+     *
+     * @param transfers Transfers, in the order they should reach each token's chain
+     * @param options Pipeline tuning and an optional per-item callback
+     * @return Future with one result per transfer, in input order
+     */
+    [[nodiscard]] std::future<std::vector<BatchTransferResult>>
+    transferTokenBatch(const std::vector<BatchTransfer>& transfers,
+                       const BatchTransferOptions& options);
+    [[nodiscard]] std::future<std::vector<BatchTransferResult>>
+    transferTokenBatch(const std::vector<BatchTransfer>& transfers);
+
     /**
      * Burn (destroy) tokens (mirroring JS burnToken)
      *
@@ -378,7 +439,6 @@ private:
     std::unique_ptr<Impl> pImpl_;
     
     // Internal helper methods
-    [[nodiscard]] std::string getRandomUri() const;
     [[nodiscard]] std::string hashSecret(const std::string& secret) const;
     void log(const std::string& level, const std::string& message) const;
     void ensureAuthenticated() const;
@@ -7,6 +7,8 @@
 #include "third_party/BigInt/bigInt.h"
 #include "Wallet.h"
 #include "utility.h"
+#include "shake256.h"
+#include "wots.h"
 #include "AtomsNotFoundException.h"
 #include "third_party/nlohmann/json.hpp"
 
@@ -50,13 +52,27 @@ std::vector<std::pair<std::string, std::string>> buildWalletMetaKeys(const Walle
 	if (!wallet.batchId.empty()) {
 		walletMeta.push_back({"walletBatchId", wallet.batchId});
 	}
-	if (!wallet.mlkem_public_key.empty()) {
-		walletMeta.push_back({"walletPubkey", toBase64(wallet.mlkem_public_key)});
+	// Derives only the ML-KEM768 pair (deterministic); the libsodium pair stays lazy
+	const auto &mlkemPublicKey = wallet.getMlkemPublicKey();
+	if (!mlkemPublicKey.empty()) {
+		walletMeta.push_back({"walletPubkey", toBase64(mlkemPublicKey)});
 	}
 	walletMeta.push_back({"walletCharacters", "BASE64"});
 	return walletMeta;
 }
 
+// Working buffers for verifyOts(), kept per thread so batch verification
+// (MoleculeVerifier) reuses their capacity from one molecule to the next
+struct OtsScratch
+{
+	std::string ots;
+	std::vector<std::string_view> chunks;
+	std::vector<int> steps;
+	std::string keyFragments;
+};
+
+thread_local OtsScratch otsScratch;
+
 } // anonymous namespace
 
 /**
@@ -457,12 +473,14 @@ std::vector<Atom> Molecule::initAuthorization(const Wallet &sourceWallet, bool e
 	// U-atom meta in JS order: encrypt first, then pubkey + characters (setAtomWallet).
 	std::vector<std::pair<std::string, std::string>> uMeta;
 	uMeta.push_back({"encrypt", encrypt ? "true" : "false"});
-	if (!sourceWallet.mlkem_public_key.empty()) {
-		uMeta.push_back({"pubkey", toBase64(sourceWallet.mlkem_public_key)});
+	const auto &mlkemPublicKey = sourceWallet.getMlkemPublicKey();
+	if (!mlkemPublicKey.empty()) {
+		const std::string encodedKey = toBase64(mlkemPublicKey);
+		uMeta.push_back({"pubkey", encodedKey});
 		// PQ-transport Phase E: convey the AUTH source wallet's ML-KEM768 public key as a SIGNED
 		// walletPubkey meta (this U-atom is signed → MITM-proof), so the validator's
 		// extract_enc_pubkey can encrypt CipherHash responses back to THIS wallet.
-		uMeta.push_back({"walletPubkey", toBase64(sourceWallet.mlkem_public_key)});
+		uMeta.push_back({"walletPubkey", encodedKey});
 	}
 	uMeta.push_back({"characters", "BASE64"});
 
@@ -514,8 +532,9 @@ void Molecule::addContinuIdAtom(const Wallet &sourceWallet, int index)
 		// USER so the next molecule's ContinuId(bundle,"USER") lookup finds it.
 		continuIdToken = this->remainderWallet->token;
 		continuIdMeta.push_back({"previousPosition", sourceWallet.position});
-		if (!this->remainderWallet->mlkem_public_key.empty()) {
-			continuIdMeta.push_back({"pubkey", toBase64(this->remainderWallet->mlkem_public_key)});
+		const auto &mlkemPublicKey = this->remainderWallet->getMlkemPublicKey();
+		if (!mlkemPublicKey.empty()) {
+			continuIdMeta.push_back({"pubkey", toBase64(mlkemPublicKey)});
 		}
 		continuIdMeta.push_back({"characters", "BASE64"});
 	}
@@ -619,26 +638,26 @@ std::string Molecule::sign(const std::string &secret, bool anonymous)
 	auto key = Wallet::generateWalletKey(secret, this->atoms.front().token, this->atoms.front().position);
 
 	// Subdivide Kk into 16 segments of 256 bytes (128 characters) each
-	auto keyChunks = chunkSubstr(key, 128);
+	const std::string_view keyView(key);
+	std::vector<std::string_view> keyChunks;
+	for (size_t offset = 0; offset < keyView.size(); offset += knishio::WOTS_CHUNK_HEX_LENGTH)
+	{
+		keyChunks.push_back(keyView.substr(offset, knishio::WOTS_CHUNK_HEX_LENGTH));
+	}
 
 	// Convert Hm to numeric notation, and then normalize
 	auto normalizedHash = Molecule::normalize(Molecule::enumerate(this->molecularHash));
 
-	// Building a one-time-signature
-	std::string signatureFragments;
-
+	// Building a one-time-signature: chunk i is hashed 8 - normalizedHash[i] times
+	std::vector<int> chainSteps(keyChunks.size());
 	for (size_t index = 0; index < keyChunks.size(); index++)
 	{
-		auto workingChunk = keyChunks[index];
-
-		for (int iterationCount = 0, condition = 8 - normalizedHash[index]; iterationCount < condition; iterationCount++)
-		{
-			workingChunk = shake256Hex(workingChunk, 512);
-		}
-
-		signatureFragments += workingChunk;
+		chainSteps[index] = 8 - normalizedHash[index];
 	}
 
+	std::string signatureFragments(keyChunks.size() * knishio::WOTS_CHUNK_HEX_LENGTH, '\0');
+	signatureFragments.resize(knishio::runWotsChains(keyChunks, chainSteps, signatureFragments));
+
 	// Chunking the signature across multiple atoms
 	auto chunkedSignature = chunkSubstr(signatureFragments, (size_t)std::round((double)signatureFragments.size() / this->atoms.size()));
 
@@ -654,6 +673,11 @@ std::string Molecule::sign(const std::string &secret, bool anonymous)
 }
 
 std::string Molecule::toJson() const
+{
+	return toJsonValue().dump();
+}
+
+nlohmann::json Molecule::toJsonValue(bool includeWalletContext) const
 {
 	nlohmann::json jsonMolecule;
 
@@ -671,7 +695,8 @@ std::string Molecule::toJson() const
 	}
 	jsonMolecule["createdAt"] = std::to_string(this->createdAt.count());
 
-	jsonMolecule["atoms"] = nlohmann::json::array();
+	auto &jsonAtoms = jsonMolecule["atoms"] = nlohmann::json::array();
+	jsonAtoms.get_ref<nlohmann::json::array_t &>().reserve(this->atoms.size());
 
 	for (const auto &atom : this->atoms)
 	{
@@ -707,7 +732,7 @@ std::string Molecule::toJson() const
 		}
 
 		// write meta
-		jsonAtom["meta"] = nlohmann::json::array();
+		auto &jsonMetas = jsonAtom["meta"] = nlohmann::json::array();
 
 		for (auto &meta : atom.meta)
 		{
@@ -715,14 +740,18 @@ std::string Molecule::toJson() const
 			jsonMeta["key"] = meta.first;
 			jsonMeta["value"] = meta.second;
 
-			jsonAtom["meta"].push_back(jsonMeta);
+			jsonMetas.push_back(std::move(jsonMeta));
 		}
 
 		jsonAtom["otsFragment"] = atom.otsFragment;
 		jsonAtom["createdAt"] = std::to_string(atom.createdAt.count());
 		jsonAtom["index"] = atom.index;  // Include index for JavaScript canonical compliance
 
-		jsonMolecule["atoms"].push_back(jsonAtom);
+		jsonAtoms.push_back(std::move(jsonAtom));
+	}
+
+	if (!includeWalletContext) {
+		return jsonMolecule;
 	}
 	
 	// Add wallet data for cross-SDK validation (matches other SDKs)
@@ -744,7 +773,7 @@ std::string Molecule::toJson() const
 		jsonMolecule["remainderWallet"] = remainderWalletJson;
 	}
 
-	return jsonMolecule.dump();
+	return jsonMolecule;
 }
 
 /**
@@ -754,45 +783,50 @@ std::string Molecule::toJson() const
   */
 Molecule Molecule::jsonToObject(const std::string &jsonStr)
 {
-	nlohmann::json json = nlohmann::json::parse(jsonStr);
+	return fromJson(nlohmann::json::parse(jsonStr));
+}
 
+Molecule Molecule::fromJson(nlohmann::json &&json)
+{
 	Molecule molecule;
 
 	auto value = json.find("molecularHash");
 
 	if (value != json.end())
 	{
-		molecule.molecularHash = value->get<std::string>();
+		molecule.molecularHash = std::move(value->get_ref<std::string &>());
 	}
 
 	value = json.find("cellSlug");
 
 	if (value != json.end() && !value->is_null())
 	{
-		molecule.cellSlug = value->get<std::string>();
+		molecule.cellSlug = std::move(value->get_ref<std::string &>());
 	}
 
 	value = json.find("bundle");
 
 	if (value != json.end())
 	{
-		molecule.bundle = value->get<std::string>();
+		molecule.bundle = std::move(value->get_ref<std::string &>());
 	}
 
 	value = json.find("status");
 
 	if (value != json.end() && !value->is_null())
 	{
-		molecule.status = value->get<std::string>();
+		molecule.status = std::move(value->get_ref<std::string &>());
 	}
 
 	value = json.find("atoms");
 
 	if (value != json.end())
 	{
+		molecule.atoms.reserve(value->size());
+
 		for (auto &jsonAtom : *value)
 		{
-			auto atom = Atom::jsonToObject(jsonAtom.dump());
+			auto atom = Atom::fromJson(std::move(jsonAtom));
 
 			if (atom.position.empty()
 				|| atom.walletAddress.empty()
@@ -801,7 +835,7 @@ Molecule Molecule::jsonToObject(const std::string &jsonStr)
 				throw AtomsNotFoundException("The required properties of the atom are not filled.");
 			}
 
-			molecule.atoms.push_back(atom);
+			molecule.atoms.push_back(std::move(atom));
 		}
 	}
 
@@ -809,7 +843,7 @@ Molecule Molecule::jsonToObject(const std::string &jsonStr)
 
 	if (value != json.end())
 	{
-		auto createdAtStr = value->get<std::string>();
+		const auto &createdAtStr = value->get_ref<const std::string &>();
 		auto createdAt = std::strtoll(createdAtStr.c_str(), NULL, 10);
 
 		molecule.createdAt = std::chrono::milliseconds(createdAt);
@@ -818,6 +852,31 @@ Molecule Molecule::jsonToObject(const std::string &jsonStr)
 	return molecule;
 }
 
+/**
+  * @param {string} json - an array of molecules
+  * @return {std::vector<Molecule>}
+  * @throws {AtomsNotFoundException}
+  */
+std::vector<Molecule> Molecule::jsonToObjects(const std::string &jsonStr)
+{
+	nlohmann::json json = nlohmann::json::parse(jsonStr);
+
+	if (!json.is_array())
+	{
+		throw std::invalid_argument("Expected a JSON array of molecules");
+	}
+
+	std::vector<Molecule> molecules;
+	molecules.reserve(json.size());
+
+	for (auto &jsonMolecule : json)
+	{
+		molecules.push_back(fromJson(std::move(jsonMolecule)));
+	}
+
+	return molecules;
+}
+
 bool Molecule::verify(const Molecule &molecule)
 {
 	// Cross-SDK validation: Hash + token balance is sufficient
@@ -875,34 +934,49 @@ bool Molecule::verifyOts(const Molecule &molecule)
 	auto enumeratedHash = Molecule::enumerate(molecule.molecularHash);
 	auto normalizedHash = Molecule::normalize(enumeratedHash);
 
-	std::string ots;
+	auto &scratch = otsScratch;
+	std::string &ots = scratch.ots;
+	ots.clear();
 
 	for (auto &atom : molecule.atoms)
 	{
 		ots += atom.otsFragment;
 	}
 
-	// Subdivide Kk into 16 segments of 256 bytes (128 characters) each
-	auto otsChunks = chunkSubstr(ots, 128);
+	// Subdivide Kk into 16 segments of 256 bytes (128 characters) each; chunk i is
+	// hashed 8 + normalizedHash[i] times to complete its chain
+	const std::string_view otsView(ots);
+	std::vector<std::string_view> &otsChunks = scratch.chunks;
+	otsChunks.clear();
+	for (size_t offset = 0; offset < otsView.size(); offset += knishio::WOTS_CHUNK_HEX_LENGTH)
+	{
+		otsChunks.push_back(otsView.substr(offset, knishio::WOTS_CHUNK_HEX_LENGTH));
+	}
 
-	std::string keyFragments;
+	// A molecule off the wire may carry more fragments than the hash has symbols
+	if (otsChunks.size() > normalizedHash.size())
+	{
+		return false;
+	}
 
+	std::vector<int> &chainSteps = scratch.steps;
+	chainSteps.resize(otsChunks.size());
 	for (size_t index = 0; index < otsChunks.size(); index++)
 	{
-		auto workingChunk = otsChunks[index];
-
-		for (int iterationCount = 0, condition = 8 + normalizedHash[index]; iterationCount < condition; iterationCount++)
-		{
-			workingChunk = shake256Hex(workingChunk, 512);
-		}
-
-		keyFragments += workingChunk;
+		chainSteps[index] = 8 + normalizedHash[index];
 	}
 
+	std::string &keyFragments = scratch.keyFragments;
+	keyFragments.resize(otsChunks.size() * knishio::WOTS_CHUNK_HEX_LENGTH);
+	keyFragments.resize(knishio::runWotsChains(otsChunks, chainSteps, keyFragments));
+
 	// Absorb the hashed Kk into the sponge to receive the digest Dk
-	auto digest = shake256Hex(keyFragments, 8192);
+	unsigned char digest[1024];
+	knishio::Shake256 digestSponge;
+	digestSponge.update(keyFragments).finalize(digest);
 	// Squeeze the sponge to retrieve a 128 byte (64 character) string that should match the sender�s wallet address
-	auto address = shake256Hex(digest, 256);
+	knishio::Shake256 addressSponge;
+	auto address = addressSponge.updateHex(digest).hexDigest(256);
 
 	return (address == molecule.atoms.front().walletAddress);
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <string_view>
+
 #include "Atom.h"
+#include "third_party/nlohmann/json.hpp"
 
 namespace KnishIO {
 
@@ -40,8 +43,21 @@ public:
 	std::string sign(const std::string &secret, bool anonymous = false);
 
 	std::string toJson() const;
+	// The document toJson() dumps. Without wallet context the sourceWallet/remainderWallet
+	// cross-SDK fields are left out, which is the MoleculeInput shape ProposeMolecule accepts.
+	nlohmann::json toJsonValue(bool includeWalletContext = true) const;
 
 	static Molecule jsonToObject(const std::string &json);
+	// Decodes an already parsed molecule node, moving its atoms' strings out of it
+	static Molecule fromJson(nlohmann::json &&json);
+	// Bulk decode of a JSON array of molecules (a validator dump), parsed once
+	static std::vector<Molecule> jsonToObjects(const std::string &json);
+
+	// Compact versioned binary form for queues and storage (see MoleculeBinary.cpp for the layout).
+	// Round-trips every field of the molecule and its atoms, so the decoded atoms hash to the
+	// same molecular hash; like jsonToObject, the wallet context is not carried.
+	std::string toBinary() const;
+	static Molecule binaryToObject(std::string_view data);
 	static std::vector<char> enumerate(const std::string &hash);
 	static std::vector<char> normalize(const std::vector<char> &mappedHashArray);
 	static bool verify(const Molecule &molecule);
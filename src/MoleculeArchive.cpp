@@ -0,0 +1,552 @@
+// 64-bit file offsets for fseeko on 32-bit POSIX targets
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "MoleculeArchive.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define KNISHIO_ARCHIVE_MMAP 1
+#endif
+
+namespace KnishIO {
+
+namespace {
+
+constexpr char DATA_MAGIC[] = {'K', 'M', 'A'};
+constexpr char INDEX_MAGIC[] = {'K', 'M', 'I'};
+constexpr char ARCHIVE_VERSION = 1;
+
+constexpr size_t HEADER_SIZE = 8;
+constexpr size_t RECORD_HEADER_SIZE = 5;	// u32 payload length, u8 hash length
+constexpr size_t HASH_WIDTH = 64;
+constexpr size_t INDEX_ENTRY_SIZE = 8 + HASH_WIDTH;
+
+std::string indexPath(const std::string &path)
+{
+	return path + ".idx";
+}
+
+uint64_t readLittleEndian(const char *bytes, size_t width)
+{
+	uint64_t value = 0;
+	for (size_t index = 0; index < width; index++)
+	{
+		value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[index])) << (8 * index);
+	}
+	return value;
+}
+
+void writeLittleEndian(char *bytes, uint64_t value, size_t width)
+{
+	for (size_t index = 0; index < width; index++)
+	{
+		bytes[index] = static_cast<char>(value >> (8 * index));
+	}
+}
+
+std::string fileHeader(const char (&magic)[3])
+{
+	std::string header(HEADER_SIZE, '\0');
+	header.replace(0, sizeof(magic), magic, sizeof(magic));
+	header[3] = ARCHIVE_VERSION;
+	return header;
+}
+
+bool hasHeader(std::string_view bytes, const char (&magic)[3])
+{
+	return bytes.size() >= HEADER_SIZE && bytes.substr(0, HEADER_SIZE) == fileHeader(magic);
+}
+
+// Hash stored in an index entry, without its zero padding
+std::string_view entryHash(const char *entry)
+{
+	std::string_view hash(entry + 8, HASH_WIDTH);
+	return hash.substr(0, hash.find('\0'));
+}
+
+void writeAll(std::FILE *file, const char *bytes, size_t size)
+{
+	if (std::fwrite(bytes, 1, size, file) != size)
+	{
+		throw std::runtime_error("Molecule archive write failed");
+	}
+}
+
+// std::fseek takes a long, which is 32 bits on Windows and 32-bit targets
+int seekTo(std::FILE *file, uint64_t offset)
+{
+#if defined(_WIN32)
+	return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+	return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+void readAll(std::FILE *file, uint64_t offset, char *bytes, size_t size)
+{
+	if (seekTo(file, offset) != 0 || std::fread(bytes, 1, size, file) != size)
+	{
+		throw std::runtime_error("Molecule archive read failed");
+	}
+}
+
+std::FILE *openFile(const std::string &path, const char *mode)
+{
+	std::FILE *file = std::fopen(path.c_str(), mode);
+	if (!file)
+	{
+		throw std::runtime_error("Cannot open molecule archive file " + path);
+	}
+	return file;
+}
+
+} // namespace
+
+MoleculeArchiveWriter::MoleculeArchiveWriter(const std::string &path)
+{
+	namespace fs = std::filesystem;
+
+	if (!fs::exists(path) || fs::file_size(path) == 0)
+	{
+		data_ = openFile(path, "w+b");
+		index_ = openFile(indexPath(path), "w+b");
+		auto dataHeader = fileHeader(DATA_MAGIC);
+		auto indexHeader = fileHeader(INDEX_MAGIC);
+		writeAll(data_, dataHeader.data(), dataHeader.size());
+		writeAll(index_, indexHeader.data(), indexHeader.size());
+		dataEnd_ = HEADER_SIZE;
+		return;
+	}
+
+	data_ = openFile(path, "r+b");
+	uint64_t dataSize = fs::file_size(path);
+	std::string header(HEADER_SIZE, '\0');
+	if (dataSize >= HEADER_SIZE)
+	{
+		readAll(data_, 0, header.data(), header.size());
+	}
+	if (!hasHeader(header, DATA_MAGIC))
+	{
+		std::fclose(data_);
+		data_ = nullptr;
+		throw std::runtime_error("Not a molecule archive: " + path);
+	}
+
+	// A missing or foreign index is rebuilt from the records; a torn last entry is dropped
+	std::string index = indexPath(path);
+	size_t entries = 0;
+	if (fs::exists(index) && fs::file_size(index) >= HEADER_SIZE)
+	{
+		index_ = openFile(index, "r+b");
+		readAll(index_, 0, header.data(), header.size());
+		if (hasHeader(header, INDEX_MAGIC))
+		{
+			entries = (fs::file_size(index) - HEADER_SIZE) / INDEX_ENTRY_SIZE;
+		}
+		else
+		{
+			std::fclose(index_);
+			index_ = nullptr;
+		}
+	}
+	if (!index_)
+	{
+		index_ = openFile(index, "w+b");
+		auto indexHeader = fileHeader(INDEX_MAGIC);
+		writeAll(index_, indexHeader.data(), indexHeader.size());
+	}
+
+	// The two files are buffered separately, so an entry can reach the disk before its record;
+	// such entries are dropped and the record, if complete, is indexed again below
+	uint64_t offset = HEADER_SIZE;
+	char entry[INDEX_ENTRY_SIZE];
+	char recordHeader[RECORD_HEADER_SIZE];
+	for (; entries > 0; entries--)
+	{
+		readAll(index_, HEADER_SIZE + (entries - 1) * INDEX_ENTRY_SIZE, entry, sizeof(entry));
+		uint64_t last = readLittleEndian(entry, 8);
+		if (last < HEADER_SIZE || last + RECORD_HEADER_SIZE > dataSize)
+		{
+			continue;
+		}
+		readAll(data_, last, recordHeader, sizeof(recordHeader));
+		uint64_t next = last + RECORD_HEADER_SIZE + static_cast<unsigned char>(recordHeader[4]) + readLittleEndian(recordHeader, 4);
+		if (next <= dataSize)
+		{
+			offset = next;
+			break;
+		}
+	}
+	std::fflush(index_);
+	fs::resize_file(index, HEADER_SIZE + entries * INDEX_ENTRY_SIZE);
+	records_ = entries;
+
+	// Records after the last indexed one were appended before a crash; a torn last one is cut off
+	std::fseek(index_, 0, SEEK_END);
+	while (offset + RECORD_HEADER_SIZE <= dataSize)
+	{
+		readAll(data_, offset, recordHeader, sizeof(recordHeader));
+		size_t hashSize = static_cast<unsigned char>(recordHeader[4]);
+		uint64_t next = offset + RECORD_HEADER_SIZE + hashSize + readLittleEndian(recordHeader, 4);
+		if (hashSize == 0 || hashSize > HASH_WIDTH || next > dataSize)
+		{
+			break;
+		}
+
+		std::fill(std::begin(entry), std::end(entry), '\0');
+		writeLittleEndian(entry, offset, 8);
+		readAll(data_, offset + RECORD_HEADER_SIZE, entry + 8, hashSize);
+		writeAll(index_, entry, sizeof(entry));
+		records_++;
+		offset = next;
+	}
+
+	if (offset < dataSize)
+	{
+		std::fflush(data_);
+		fs::resize_file(path, offset);
+	}
+	dataEnd_ = offset;
+	std::fseek(data_, 0, SEEK_END);
+	std::fseek(index_, 0, SEEK_END);
+}
+
+MoleculeArchiveWriter::~MoleculeArchiveWriter()
+{
+	if (data_)
+	{
+		std::fclose(data_);
+	}
+	if (index_)
+	{
+		std::fclose(index_);
+	}
+}
+
+void MoleculeArchiveWriter::checkUsable() const
+{
+	if (failed_)
+	{
+		throw std::runtime_error("Molecule archive writer failed earlier; reopen the archive to recover it");
+	}
+}
+
+uint64_t MoleculeArchiveWriter::append(const Molecule &molecule)
+{
+	checkUsable();
+
+	const auto &hash = molecule.molecularHash;
+	if (hash.empty() || hash.size() > HASH_WIDTH)
+	{
+		throw std::invalid_argument("Archived molecules need a molecular hash of 1 to 64 characters");
+	}
+
+	auto payload = molecule.toBinary();
+	if (payload.size() > UINT32_MAX)
+	{
+		throw std::invalid_argument("Molecule too large to archive");
+	}
+
+	char recordHeader[RECORD_HEADER_SIZE];
+	writeLittleEndian(recordHeader, payload.size(), 4);
+	recordHeader[4] = static_cast<char>(hash.size());
+
+	char entry[INDEX_ENTRY_SIZE] = {};
+	writeLittleEndian(entry, dataEnd_, 8);
+	hash.copy(entry + 8, hash.size());
+
+	// Record before index entry: a crash in between leaves a record the next writer indexes.
+	// After a failed write the files hold a partial record, so every later offset would be
+	// wrong; the writer refuses further appends and reopening cuts the partial record off.
+	try
+	{
+		writeAll(data_, recordHeader, sizeof(recordHeader));
+		writeAll(data_, hash.data(), hash.size());
+		writeAll(data_, payload.data(), payload.size());
+		writeAll(index_, entry, sizeof(entry));
+	}
+	catch (...)
+	{
+		failed_ = true;
+		throw;
+	}
+
+	uint64_t offset = dataEnd_;
+	dataEnd_ += RECORD_HEADER_SIZE + hash.size() + payload.size();
+	records_++;
+	return offset;
+}
+
+void MoleculeArchiveWriter::flush()
+{
+	checkUsable();
+	if (std::fflush(data_) != 0 || std::fflush(index_) != 0)
+	{
+		failed_ = true;
+		throw std::runtime_error("Molecule archive flush failed");
+	}
+}
+
+MoleculeArchive::MoleculeArchive(const std::string &path, bool mapFiles)
+{
+	load(data_, path, mapFiles);
+	std::string_view data(data_.bytes, data_.size);
+	if (!hasHeader(data, DATA_MAGIC))
+	{
+		release(data_);
+		throw std::runtime_error("Not a molecule archive: " + path);
+	}
+	mapped_ = data_.mapped;
+	dataEnd_ = HEADER_SIZE;
+
+	if (std::filesystem::exists(indexPath(path)))
+	{
+		load(index_, indexPath(path), mapFiles);
+	}
+
+	// Index entries whose record is complete, then any records the index is missing
+	std::string_view index(index_.bytes, index_.size);
+	if (hasHeader(index, INDEX_MAGIC))
+	{
+		size_t entries = (index.size() - HEADER_SIZE) / INDEX_ENTRY_SIZE;
+		offsets_.reserve(entries);
+		for (size_t entry = 0; entry < entries; entry++)
+		{
+			const char *bytes = index_.bytes + HEADER_SIZE + entry * INDEX_ENTRY_SIZE;
+			uint64_t offset = readLittleEndian(bytes, 8);
+			auto record = recordAt(offset);
+			if (!record)
+			{
+				break;
+			}
+			offsets_.emplace(entryHash(bytes), offset);
+			records_++;
+			dataEnd_ = std::max<uint64_t>(dataEnd_, offset + RECORD_HEADER_SIZE + record->molecularHash.size() + record->data.size());
+		}
+	}
+
+	for (auto record = recordAt(dataEnd_); record; record = recordAt(dataEnd_))
+	{
+		offsets_.emplace(record->molecularHash, record->offset);
+		records_++;
+		dataEnd_ = record->offset + RECORD_HEADER_SIZE + record->molecularHash.size() + record->data.size();
+	}
+}
+
+MoleculeArchive::~MoleculeArchive()
+{
+	release(data_);
+	release(index_);
+}
+
+void MoleculeArchive::load(File &file, const std::string &path, bool mapFile)
+{
+#ifdef KNISHIO_ARCHIVE_MMAP
+	if (mapFile)
+	{
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			throw std::runtime_error("Cannot open molecule archive file " + path);
+		}
+		struct stat status;
+		if (::fstat(fd, &status) == 0 && status.st_size > 0)
+		{
+			void *bytes = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (bytes != MAP_FAILED)
+			{
+				::close(fd);
+				::madvise(bytes, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+				file.bytes = static_cast<const char *>(bytes);
+				file.size = static_cast<size_t>(status.st_size);
+				file.mapped = true;
+				return;
+			}
+		}
+		::close(fd);
+	}
+#else
+	(void)mapFile;
+#endif
+
+	// Read fallback: no mmap on this platform, or it failed
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+	{
+		throw std::runtime_error("Cannot open molecule archive file " + path);
+	}
+	file.buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	file.bytes = file.buffer.data();
+	file.size = file.buffer.size();
+	file.mapped = false;
+}
+
+void MoleculeArchive::release(File &file)
+{
+#ifdef KNISHIO_ARCHIVE_MMAP
+	if (file.mapped)
+	{
+		::munmap(const_cast<char *>(file.bytes), file.size);
+	}
+#endif
+	file = File{};
+}
+
+std::optional<MoleculeArchive::Record> MoleculeArchive::recordAt(uint64_t offset) const
+{
+	if (offset < HEADER_SIZE || offset + RECORD_HEADER_SIZE > data_.size)
+	{
+		return std::nullopt;
+	}
+	const char *bytes = data_.bytes + offset;
+	size_t hashSize = static_cast<unsigned char>(bytes[4]);
+	uint64_t payloadSize = readLittleEndian(bytes, 4);
+	if (hashSize == 0 || hashSize > HASH_WIDTH || offset + RECORD_HEADER_SIZE + hashSize + payloadSize > data_.size)
+	{
+		return std::nullopt;
+	}
+
+	Record record;
+	record.offset = offset;
+	record.molecularHash = std::string_view(bytes + RECORD_HEADER_SIZE, hashSize);
+	record.data = std::string_view(bytes + RECORD_HEADER_SIZE + hashSize, static_cast<size_t>(payloadSize));
+	return record;
+}
+
+std::optional<MoleculeArchive::Record> MoleculeArchive::find(std::string_view molecularHash) const
+{
+	auto found = offsets_.find(molecularHash);
+	if (found == offsets_.end())
+	{
+		return std::nullopt;
+	}
+	auto record = recordAt(found->second);
+	if (!record || record->molecularHash != molecularHash)
+	{
+		return std::nullopt;
+	}
+	return record;
+}
+
+std::optional<Molecule> MoleculeArchive::get(std::string_view molecularHash) const
+{
+	auto record = find(molecularHash);
+	if (!record)
+	{
+		return std::nullopt;
+	}
+	return record->molecule();
+}
+
+MoleculeArchive::Iterator MoleculeArchive::begin() const
+{
+	return Iterator(this, HEADER_SIZE);
+}
+
+MoleculeArchive::Iterator MoleculeArchive::end() const
+{
+	return Iterator(this, dataEnd_);
+}
+
+MoleculeArchive::Iterator::Iterator(const MoleculeArchive *archive, uint64_t offset)
+	: archive_(archive)
+{
+	record_.offset = archive->dataEnd_;
+	if (offset < archive->dataEnd_)
+	{
+		if (auto record = archive->recordAt(offset))
+		{
+			record_ = *record;
+		}
+	}
+}
+
+MoleculeArchive::Iterator &MoleculeArchive::Iterator::operator++()
+{
+	*this = Iterator(archive_, record_.offset + RECORD_HEADER_SIZE + record_.molecularHash.size() + record_.data.size());
+	return *this;
+}
+
+MoleculeArchive::Iterator MoleculeArchive::Iterator::operator++(int)
+{
+	Iterator previous = *this;
+	++*this;
+	return previous;
+}
+
+size_t MoleculeArchive::verify(MoleculeVerifier &verifier
+	, const std::function<void(const Record &, const MoleculeVerification &)> &onResult
+	, size_t batchSize) const
+{
+	batchSize = std::max<size_t>(batchSize, 1);
+
+	std::vector<Record> records;
+	std::vector<Molecule> molecules;
+	std::vector<bool> undecodable;
+	std::vector<MoleculeVerification> results;
+	records.reserve(batchSize);
+	molecules.reserve(batchSize);
+	size_t valid = 0;
+
+	auto flushBatch = [&]()
+	{
+		results.assign(molecules.size(), MoleculeVerification{});
+		verifier.verify(molecules, results);
+		for (size_t index = 0; index < records.size(); index++)
+		{
+			if (undecodable[index])
+			{
+				results[index] = {MoleculeVerifyStatus::Error, "archived record could not be decoded"};
+			}
+			if (results[index].valid())
+			{
+				valid++;
+			}
+			if (onResult)
+			{
+				onResult(records[index], results[index]);
+			}
+		}
+		records.clear();
+		molecules.clear();
+		undecodable.clear();
+	};
+
+	for (const auto &record : *this)
+	{
+		records.push_back(record);
+		try
+		{
+			molecules.push_back(record.molecule());
+			undecodable.push_back(false);
+		}
+		catch (const std::exception &)
+		{
+			molecules.emplace_back();
+			undecodable.push_back(true);
+		}
+		if (records.size() == batchSize)
+		{
+			flushBatch();
+		}
+	}
+	if (!records.empty())
+	{
+		flushBatch();
+	}
+	return valid;
+}
+
+} // namespace KnishIO
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Molecule.h"
+#include "MoleculeVerifier.h"
+
+namespace KnishIO {
+
+/**
+ * Append-only archive of signed molecules
+ *
+ * Two files: `path` holds the records, `path + ".idx"` maps molecular hashes
+ * to record offsets.
+ *
+ *   data:  "KMA" version(1) 4 reserved bytes, then records of
+ *          u32 payload length, u8 hash length, molecular hash, payload
+ *   index: "KMI" version(1) 4 reserved bytes, then fixed 72-byte entries of
+ *          u64 record offset, molecular hash zero-padded to 64 bytes
+ *
+ * Integers are little-endian; the payload is Molecule::toBinary(). Records
+ * are only ever appended, so a crash can at most leave a torn last record,
+ * which MoleculeArchiveWriter drops when it reopens the archive and
+ * MoleculeArchive never reads.
+ */
+
+/**
+ * class MoleculeArchiveWriter
+ *
+ * Creates an archive or reopens one for appending. Not thread-safe.
+ */
+class MoleculeArchiveWriter
+{
+public:
+	// Reopening indexes records the index is missing and truncates a torn last record
+	explicit MoleculeArchiveWriter(const std::string &path);
+	~MoleculeArchiveWriter();
+
+	MoleculeArchiveWriter(const MoleculeArchiveWriter &) = delete;
+	MoleculeArchiveWriter &operator=(const MoleculeArchiveWriter &) = delete;
+
+	// Returns the record's offset; the molecule needs a molecular hash of at most 64 characters.
+	// After a write or flush error every call throws; a new writer on the path recovers the archive.
+	uint64_t append(const Molecule &molecule);
+	// Hands buffered records to the OS; readers opened afterwards see them
+	void flush();
+
+	size_t size() const { return records_; }
+	bool failed() const { return failed_; }
+
+private:
+	void checkUsable() const;
+
+	std::FILE	*data_ = nullptr;
+	std::FILE	*index_ = nullptr;
+	uint64_t	dataEnd_ = 0;
+	size_t		records_ = 0;
+	bool		failed_ = false;
+};
+
+/**
+ * class MoleculeArchive
+ *
+ * Read-only view of an archive as it was when opened. The files are mapped
+ * into memory where the platform supports it, and read into memory
+ * otherwise; records are handed out as views into that memory. Lookups by
+ * molecular hash use the index, iteration walks the records in append order.
+ */
+class MoleculeArchive
+{
+public:
+	struct Record
+	{
+		uint64_t			offset = 0;
+		std::string_view	molecularHash;
+		std::string_view	data;		// Molecule::toBinary() form
+
+		Molecule molecule() const { return Molecule::binaryToObject(data); }
+	};
+
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Record;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Record *;
+		using reference = const Record &;
+
+		Iterator() = default;
+
+		reference operator*() const { return record_; }
+		pointer operator->() const { return &record_; }
+		Iterator &operator++();
+		Iterator operator++(int);
+		bool operator==(const Iterator &other) const { return archive_ == other.archive_ && record_.offset == other.record_.offset; }
+
+	private:
+		friend class MoleculeArchive;
+		Iterator(const MoleculeArchive *archive, uint64_t offset);
+
+		const MoleculeArchive	*archive_ = nullptr;
+		Record					record_;
+	};
+
+	explicit MoleculeArchive(const std::string &path, bool mapFiles = true);
+	~MoleculeArchive();
+
+	MoleculeArchive(const MoleculeArchive &) = delete;
+	MoleculeArchive &operator=(const MoleculeArchive &) = delete;
+
+	// Number of records; a molecular hash archived twice is found at its first record
+	size_t size() const { return records_; }
+	bool mapped() const { return mapped_; }
+
+	std::optional<Record> find(std::string_view molecularHash) const;
+	std::optional<Molecule> get(std::string_view molecularHash) const;
+
+	Iterator begin() const;
+	Iterator end() const;
+
+	// Re-verifies every record in append order, batchSize molecules at a time; returns the
+	// number of valid molecules
+	size_t verify(MoleculeVerifier &verifier
+		, const std::function<void(const Record &, const MoleculeVerification &)> &onResult = {}
+		, size_t batchSize = 1024) const;
+
+private:
+	struct File
+	{
+		const char	*bytes = nullptr;
+		size_t		size = 0;
+		bool		mapped = false;
+		std::string	buffer;		// read fallback
+	};
+
+	static void load(File &file, const std::string &path, bool mapFile);
+	static void release(File &file);
+
+	// The record at offset, if it is complete
+	std::optional<Record> recordAt(uint64_t offset) const;
+
+	File													data_;
+	File													index_;
+	bool													mapped_ = false;
+	uint64_t												dataEnd_ = 0;	// end of the last complete record
+	size_t													records_ = 0;
+	std::unordered_map<std::string_view, uint64_t>			offsets_;		// views into the index
+};
+
+} // namespace KnishIO
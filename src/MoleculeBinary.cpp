@@ -0,0 +1,402 @@
+#include "Molecule.h"
+
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "AtomsNotFoundException.h"
+#include "encoding.h"
+
+/**
+ * Binary molecule encoding (version 1)
+ *
+ *   "KMB" version
+ *   varint count, count x (varint length, bytes)	interned strings
+ *   field molecularHash, field cellSlug, field bundle, field status, svarint createdAt
+ *   varint atomCount, then per atom:
+ *     field position, field walletAddress, ref isotope, ref token, field value, field batchId,
+ *     ref metaType, field metaId, varint metaCount x (ref key, field value),
+ *     field otsFragment, svarint (createdAt - molecule createdAt), svarint index
+ *
+ * varint is unsigned LEB128, svarint is a zigzag varint, ref is a varint index into the
+ * interned strings. A field starts with varint (n << 2 | kind):
+ *   kind 0: n raw bytes
+ *   kind 1: n lowercase hex digits packed two per byte (the last nibble is padding when n is odd)
+ *   kind 2: a canonical decimal integer, stored as the following svarint
+ *
+ * Every field round-trips byte for byte, so the decoded atoms hash to the same molecular hash.
+ */
+
+namespace KnishIO {
+
+namespace {
+
+constexpr char BINARY_MAGIC[] = {'K', 'M', 'B'};
+constexpr uint8_t BINARY_VERSION = 1;
+
+constexpr uint64_t FIELD_RAW = 0;
+constexpr uint64_t FIELD_HEX = 1;
+constexpr uint64_t FIELD_DECIMAL = 2;
+
+// Longest decimal that always fits an int64_t
+constexpr size_t MAX_DECIMAL_DIGITS = 18;
+
+bool isLowerHex(std::string_view text)
+{
+	for (char c : text)
+	{
+		if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f')))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Decimal text that prints back identically: no sign on zero, no leading zeros, no '+'
+bool isCanonicalDecimal(std::string_view text)
+{
+	auto digits = !text.empty() && text.front() == '-' ? text.substr(1) : text;
+	if (digits.empty() || digits.size() > MAX_DECIMAL_DIGITS)
+	{
+		return false;
+	}
+	if (digits.front() == '0' && (digits.size() > 1 || digits.size() != text.size()))
+	{
+		return false;
+	}
+	for (char c : digits)
+	{
+		if (c < '0' || c > '9')
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+uint64_t zigzag(int64_t value)
+{
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value)
+{
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+class BinaryWriter
+{
+public:
+	void varint(uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<char>(value));
+	}
+
+	void svarint(int64_t value)
+	{
+		varint(zigzag(value));
+	}
+
+	void bytes(std::string_view data)
+	{
+		varint(data.size());
+		out.append(data);
+	}
+
+	void field(std::string_view text)
+	{
+		if (isCanonicalDecimal(text))
+		{
+			int64_t number = 0;
+			std::from_chars(text.data(), text.data() + text.size(), number);
+			varint(FIELD_DECIMAL);
+			svarint(number);
+			return;
+		}
+		if (text.empty() || !isLowerHex(text))
+		{
+			varint(text.size() << 2 | FIELD_RAW);
+			out.append(text);
+			return;
+		}
+
+		varint(text.size() << 2 | FIELD_HEX);
+		size_t evenDigits = text.size() & ~size_t(1);
+		size_t offset = out.size();
+		out.resize(offset + (text.size() + 1) / 2);
+		auto *packed = reinterpret_cast<unsigned char *>(out.data() + offset);
+		knishio::hexDecode(text.substr(0, evenDigits), packed);
+		if (evenDigits != text.size())
+		{
+			char last = text.back();
+			packed[evenDigits / 2] = static_cast<unsigned char>((last <= '9' ? last - '0' : last - 'a' + 10) << 4);
+		}
+	}
+
+	// Interned strings repeat across atoms (isotopes, the token, meta keys)
+	void ref(const std::string &text)
+	{
+		auto found = indexes.find(text);
+		if (found == indexes.end())
+		{
+			found = indexes.emplace(text, strings.size()).first;
+			strings.push_back(&found->first);
+		}
+		varint(found->second);
+	}
+
+	std::string finish()
+	{
+		BinaryWriter header;
+		header.out.append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+		header.out.push_back(static_cast<char>(BINARY_VERSION));
+		header.varint(strings.size());
+		for (const auto *text : strings)
+		{
+			header.bytes(*text);
+		}
+		header.out.reserve(header.out.size() + out.size());
+		header.out.append(out);
+		return std::move(header.out);
+	}
+
+private:
+	std::string out;
+	std::unordered_map<std::string, uint64_t> indexes;
+	std::vector<const std::string *> strings;
+};
+
+class BinaryReader
+{
+public:
+	explicit BinaryReader(std::string_view data)
+		: in(data)
+	{
+	}
+
+	uint64_t varint()
+	{
+		uint64_t value = 0;
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			auto byte = static_cast<uint8_t>(take(1).front());
+			value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+			{
+				return value;
+			}
+		}
+		throw std::invalid_argument("Invalid binary molecule: varint too long");
+	}
+
+	int64_t svarint()
+	{
+		return unzigzag(varint());
+	}
+
+	std::string_view take(uint64_t size)
+	{
+		if (size > in.size())
+		{
+			throw std::invalid_argument("Invalid binary molecule: truncated");
+		}
+		auto data = in.substr(0, static_cast<size_t>(size));
+		in.remove_prefix(static_cast<size_t>(size));
+		return data;
+	}
+
+	std::string field()
+	{
+		uint64_t header = varint();
+		uint64_t size = header >> 2;
+		switch (header & 3)
+		{
+		case FIELD_RAW:
+			return std::string(take(size));
+
+		case FIELD_HEX:
+		{
+			if (size > in.size() * 2)
+			{
+				throw std::invalid_argument("Invalid binary molecule: truncated");
+			}
+			auto packed = take((size + 1) / 2);
+			std::string text(packed.size() * 2, '\0');
+			knishio::hexEncode({reinterpret_cast<const unsigned char *>(packed.data()), packed.size()}, text.data());
+			text.resize(static_cast<size_t>(size));
+			return text;
+		}
+
+		case FIELD_DECIMAL:
+			return std::to_string(svarint());
+
+		default:
+			throw std::invalid_argument("Invalid binary molecule: unknown field kind");
+		}
+	}
+
+	const std::string &ref()
+	{
+		uint64_t index = varint();
+		if (index >= strings.size())
+		{
+			throw std::invalid_argument("Invalid binary molecule: string reference out of range");
+		}
+		return strings[static_cast<size_t>(index)];
+	}
+
+	void readHeader()
+	{
+		if (take(sizeof(BINARY_MAGIC)) != std::string_view(BINARY_MAGIC, sizeof(BINARY_MAGIC)))
+		{
+			throw std::invalid_argument("Invalid binary molecule: bad magic");
+		}
+		auto version = static_cast<uint8_t>(take(1).front());
+		if (version != BINARY_VERSION)
+		{
+			throw std::invalid_argument("Unsupported binary molecule version " + std::to_string(version));
+		}
+
+		uint64_t count = varint();
+		// Each entry takes at least its length byte
+		if (count > in.size())
+		{
+			throw std::invalid_argument("Invalid binary molecule: truncated");
+		}
+		strings.reserve(static_cast<size_t>(count));
+		for (uint64_t index = 0; index < count; index++)
+		{
+			strings.emplace_back(take(varint()));
+		}
+	}
+
+	// Upper bound for a count read from the input: every item takes at least one byte
+	size_t count()
+	{
+		uint64_t value = varint();
+		if (value > in.size())
+		{
+			throw std::invalid_argument("Invalid binary molecule: truncated");
+		}
+		return static_cast<size_t>(value);
+	}
+
+	bool atEnd() const
+	{
+		return in.empty();
+	}
+
+private:
+	std::string_view in;
+	std::vector<std::string> strings;
+};
+
+} // namespace
+
+std::string Molecule::toBinary() const
+{
+	BinaryWriter writer;
+
+	writer.field(this->molecularHash);
+	writer.field(this->cellSlug);
+	writer.field(this->bundle);
+	writer.field(this->status);
+	writer.svarint(this->createdAt.count());
+
+	writer.varint(this->atoms.size());
+	for (const auto &atom : this->atoms)
+	{
+		writer.field(atom.position);
+		writer.field(atom.walletAddress);
+		writer.ref(atom.isotope);
+		writer.ref(atom.token);
+		writer.field(atom.value);
+		writer.field(atom.batchId);
+		writer.ref(atom.metaType);
+		writer.field(atom.metaId);
+
+		writer.varint(atom.meta.size());
+		for (const auto &meta : atom.meta)
+		{
+			writer.ref(meta.first);
+			writer.field(meta.second);
+		}
+
+		writer.field(atom.otsFragment);
+		writer.svarint(atom.createdAt.count() - this->createdAt.count());
+		writer.svarint(atom.index);
+	}
+
+	return writer.finish();
+}
+
+/**
+  * @param {string_view} data
+  * @return {Molecule}
+  * @throws {std::invalid_argument} on malformed input or an unknown version
+  * @throws {AtomsNotFoundException}
+  */
+Molecule Molecule::binaryToObject(std::string_view data)
+{
+	BinaryReader reader(data);
+	reader.readHeader();
+
+	Molecule molecule;
+	molecule.molecularHash = reader.field();
+	molecule.cellSlug = reader.field();
+	molecule.bundle = reader.field();
+	molecule.status = reader.field();
+	molecule.createdAt = std::chrono::milliseconds(reader.svarint());
+
+	size_t atomCount = reader.count();
+	molecule.atoms.reserve(atomCount);
+	for (size_t atomIndex = 0; atomIndex < atomCount; atomIndex++)
+	{
+		Atom atom("", "", "");
+		atom.position = reader.field();
+		atom.walletAddress = reader.field();
+		atom.isotope = reader.ref();
+		atom.token = reader.ref();
+		atom.value = reader.field();
+		atom.batchId = reader.field();
+		atom.metaType = reader.ref();
+		atom.metaId = reader.field();
+
+		size_t metaCount = reader.count();
+		atom.meta.reserve(metaCount);
+		for (size_t metaIndex = 0; metaIndex < metaCount; metaIndex++)
+		{
+			const auto &key = reader.ref();
+			atom.meta.emplace_back(key, reader.field());
+		}
+
+		atom.otsFragment = reader.field();
+		atom.createdAt = molecule.createdAt + std::chrono::milliseconds(reader.svarint());
+		atom.index = static_cast<int>(reader.svarint());
+
+		if (atom.position.empty()
+			|| atom.walletAddress.empty()
+			|| atom.isotope.empty())
+		{
+			throw AtomsNotFoundException("The required properties of the atom are not filled.");
+		}
+
+		molecule.atoms.push_back(std::move(atom));
+	}
+
+	if (!reader.atEnd())
+	{
+		throw std::invalid_argument("Invalid binary molecule: trailing data");
+	}
+
+	return molecule;
+}
+
+} // namespace KnishIO
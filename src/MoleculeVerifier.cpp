@@ -0,0 +1,206 @@
+#include "MoleculeVerifier.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "Molecule.h"
+
+namespace KnishIO {
+
+struct MoleculeVerifier::Impl
+{
+	Options options;
+	std::vector<std::thread> workers;
+
+	// Worker wake-up: a new batch bumps the generation
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	uint64_t generation = 0;
+	size_t busy = 0;
+	bool stopping = false;
+
+	// Current batch; verify() holds batchMutex while it is set
+	std::mutex batchMutex;
+	std::span<const Molecule> molecules;
+	std::span<MoleculeVerification> results;
+	std::atomic<size_t> next{0};
+	size_t grain = 1;
+
+	void work()
+	{
+		for (;;)
+		{
+			size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+			if (begin >= molecules.size())
+			{
+				return;
+			}
+			size_t end = std::min(begin + grain, molecules.size());
+			for (size_t index = begin; index < end; index++)
+			{
+				results[index] = MoleculeVerifier::verifyOne(molecules[index], options.checkOts);
+			}
+		}
+	}
+
+	void workerLoop()
+	{
+		uint64_t seen = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;)
+		{
+			wake.wait(lock, [&] { return stopping || generation != seen; });
+			if (stopping)
+			{
+				return;
+			}
+			seen = generation;
+
+			lock.unlock();
+			work();
+			lock.lock();
+
+			if (--busy == 0)
+			{
+				done.notify_all();
+			}
+		}
+	}
+};
+
+MoleculeVerifier::MoleculeVerifier()
+	: MoleculeVerifier(Options())
+{
+}
+
+MoleculeVerifier::MoleculeVerifier(const Options &options)
+	: pImpl_(std::make_unique<Impl>())
+{
+	pImpl_->options = options;
+
+	size_t threads = options.threads;
+	if (threads == 0)
+	{
+		threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+
+	// The calling thread is one of the workers
+	pImpl_->workers.reserve(threads - 1);
+	for (size_t index = 1; index < threads; index++)
+	{
+		pImpl_->workers.emplace_back([impl = pImpl_.get()] { impl->workerLoop(); });
+	}
+}
+
+MoleculeVerifier::~MoleculeVerifier()
+{
+	{
+		std::lock_guard<std::mutex> lock(pImpl_->mutex);
+		pImpl_->stopping = true;
+	}
+	pImpl_->wake.notify_all();
+
+	for (auto &worker : pImpl_->workers)
+	{
+		worker.join();
+	}
+}
+
+size_t MoleculeVerifier::threadCount() const
+{
+	return pImpl_->workers.size() + 1;
+}
+
+std::vector<MoleculeVerification> MoleculeVerifier::verify(std::span<const Molecule> molecules)
+{
+	std::vector<MoleculeVerification> results(molecules.size());
+	verify(molecules, results);
+	return results;
+}
+
+void MoleculeVerifier::verify(std::span<const Molecule> molecules, std::span<MoleculeVerification> results)
+{
+	if (molecules.size() != results.size())
+	{
+		throw std::invalid_argument("MoleculeVerifier: results must have one entry per molecule");
+	}
+
+	std::lock_guard<std::mutex> batchLock(pImpl_->batchMutex);
+	auto &impl = *pImpl_;
+
+	impl.molecules = molecules;
+	impl.results = results;
+	impl.next.store(0, std::memory_order_relaxed);
+	// Runs of several molecules keep the shared counter cool on big batches;
+	// small batches still spread one molecule per grab
+	impl.grain = std::clamp<size_t>(molecules.size() / (threadCount() * 8), 1, 16);
+
+	// Only wake the pool when there is more than one molecule to share out
+	bool parallel = !impl.workers.empty() && molecules.size() > 1;
+	if (parallel)
+	{
+		{
+			std::lock_guard<std::mutex> lock(impl.mutex);
+			impl.generation++;
+			impl.busy = impl.workers.size();
+		}
+		impl.wake.notify_all();
+	}
+
+	impl.work();
+
+	if (parallel)
+	{
+		std::unique_lock<std::mutex> lock(impl.mutex);
+		impl.done.wait(lock, [&] { return impl.busy == 0; });
+	}
+
+	impl.molecules = {};
+	impl.results = {};
+}
+
+MoleculeVerification MoleculeVerifier::verifyOne(const Molecule &molecule, bool checkOts)
+{
+	if (molecule.atoms.empty() || molecule.molecularHash.empty())
+	{
+		return {MoleculeVerifyStatus::Empty, "molecule has no atoms or no molecular hash"};
+	}
+
+	try
+	{
+		if (!Molecule::verifyMolecularHash(molecule))
+		{
+			return {MoleculeVerifyStatus::MolecularHashMismatch, "molecular hash does not match the atoms"};
+		}
+
+		try
+		{
+			if (!Molecule::verifyTokenIsotopeV(molecule))
+			{
+				return {MoleculeVerifyStatus::TokenImbalance, "V-isotope values do not sum to zero"};
+			}
+		}
+		catch (const std::runtime_error &)
+		{
+			return {MoleculeVerifyStatus::InvalidIsotopeValue, "invalid V-isotope value"};
+		}
+
+		if (checkOts && !Molecule::verifyOts(molecule))
+		{
+			return {MoleculeVerifyStatus::OtsMismatch, "OTS signature does not match the signing wallet address"};
+		}
+	}
+	catch (const std::exception &)
+	{
+		return {MoleculeVerifyStatus::Error, "exception while verifying molecule"};
+	}
+
+	return {MoleculeVerifyStatus::Valid, ""};
+}
+
+} // namespace KnishIO
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace KnishIO {
+
+class Molecule;
+
+/**
+ * Outcome of verifying one molecule, in the order the checks run
+ */
+enum class MoleculeVerifyStatus
+{
+	Valid,
+	Empty,					// no atoms or no molecular hash
+	MolecularHashMismatch,	// verifyMolecularHash() failed
+	TokenImbalance,			// verifyTokenIsotopeV() returned false
+	InvalidIsotopeValue,	// a V-isotope value is not a number
+	OtsMismatch,			// verifyOts() failed
+	Error					// any other exception while verifying
+};
+
+struct MoleculeVerification
+{
+	MoleculeVerifyStatus	status = MoleculeVerifyStatus::Valid;
+	const char				*reason = "";	// static text, never owned
+
+	bool valid() const { return status == MoleculeVerifyStatus::Valid; }
+};
+
+/**
+ * class MoleculeVerifier
+ *
+ * Verifies batches of molecules on a fixed pool of worker threads. Each
+ * molecule goes through the same checks as Molecule::verify() - molecular
+ * hash, then V-isotope balance - followed, unless disabled, by the WOTS+
+ * signature (Molecule::verifyOts()), and gets its own result with a reason.
+ *
+ * Workers take molecules from the batch in small runs and keep their
+ * signature-chain buffers between molecules, so a long stream does not
+ * allocate per chain. The calling thread works on the batch too; verify()
+ * calls are serialized.
+ */
+class MoleculeVerifier
+{
+public:
+	struct Options
+	{
+		size_t	threads = 0;		// total threads including the caller (0 = hardware concurrency)
+		bool	checkOts = true;	// also verify the WOTS+ signature
+	};
+
+	MoleculeVerifier();
+	explicit MoleculeVerifier(const Options &options);
+	~MoleculeVerifier();
+
+	MoleculeVerifier(const MoleculeVerifier &) = delete;
+	MoleculeVerifier &operator=(const MoleculeVerifier &) = delete;
+
+	std::vector<MoleculeVerification> verify(std::span<const Molecule> molecules);
+	// results must have the same length as molecules
+	void verify(std::span<const Molecule> molecules, std::span<MoleculeVerification> results);
+
+	size_t threadCount() const;
+
+	// Single-molecule check used by the workers
+	static MoleculeVerification verifyOne(const Molecule &molecule, bool checkOts = true);
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> pImpl_;
+};
+
+} // namespace KnishIO
@@ -1,12 +1,19 @@
 #include "Wallet.h"
 
 #include "utility.h"
+#include "encoding.h"
+#include "aead.h"
+#include "mlkem.h"
+#include "shake256.h"
+#include "wots.h"
+#include "WalletCache.h"
 #include "crypto.h"
 #include "crypto_bigint.h"
 #include "third_party/BigInt/bigInt.h"
 #include "third_party/nlohmann/json.hpp"
 #include "KnishIOClient.h"
 #include <sodium.h>
+#include <atomic>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 
@@ -36,10 +43,160 @@ Wallet::Wallet(const std::string &secret, const std::string &token, const std::s
 	this->address = Wallet::generateWalletAddress(this->key);
 	this->bundle = generateBundleHash(secret);
 
-	generatePublicAndPrivateKeys(this->privkey, this->pubkey);
-	
-	// Initialize ML-KEM768 keys for JavaScript compatibility
-	initializeMLKEM();
+	if (keyGeneration() == KeyGeneration::Eager)
+	{
+		generateKeys();
+	}
+}
+
+Wallet::Wallet(const std::string &secret, const std::string &token, const std::string &position, WalletCache &cache,
+	CacheUse use, size_t saltLength)
+	: position(position)
+	, token(token)
+{
+	if (this->position.empty())
+	{
+		this->position = randomString(saltLength, "abcdef0123456789");
+	}
+
+	// The bundle is one SHAKE pass over the secret and completes the cache key
+	this->bundle = generateBundleHash(secret);
+
+	if (use == CacheUse::Spend ? cache.take(*this) : cache.restore(*this))
+	{
+		keyState.mlkemReady.store(!mlkem_public_key.empty(), std::memory_order_release);
+	}
+	else
+	{
+		this->key = Wallet::generateWalletKey(secret, this->token, this->position);
+		this->address = Wallet::generateWalletAddress(this->key);
+	}
+
+	// The entry carries the derived key and address; most remainders are only ever used for
+	// those, so the ML-KEM768 pair stays lazy until the spending wallet needs it
+	if (use == CacheUse::Record)
+	{
+		cache.store(*this);
+	}
+
+	if (keyGeneration() == KeyGeneration::Eager)
+	{
+		generateKeys();
+	}
+}
+
+namespace {
+
+std::atomic<Wallet::KeyGeneration> keyGenerationMode{Wallet::KeyGeneration::Lazy};
+
+} // anonymous namespace
+
+void Wallet::setKeyGeneration(KeyGeneration mode)
+{
+	keyGenerationMode.store(mode, std::memory_order_relaxed);
+}
+
+Wallet::KeyGeneration Wallet::keyGeneration()
+{
+	return keyGenerationMode.load(std::memory_order_relaxed);
+}
+
+Wallet::KeyState::KeyState(const KeyState &other)
+	: mlkemReady(other.mlkemReady.load(std::memory_order_acquire))
+	, boxReady(other.boxReady.load(std::memory_order_acquire))
+{
+}
+
+Wallet::KeyState &Wallet::KeyState::operator=(const KeyState &other)
+{
+	mlkemReady.store(other.mlkemReady.load(std::memory_order_acquire), std::memory_order_release);
+	boxReady.store(other.boxReady.load(std::memory_order_acquire), std::memory_order_release);
+	return *this;
+}
+
+/**
+  * Derives the ML-KEM768 key pair from the wallet key, once (a cache hit already restored it).
+  * This is all molecule meta needs.
+  */
+void Wallet::ensureMlkemKeys() const
+{
+	if (keyState.mlkemReady.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(keyState.mutex);
+	if (!keyState.mlkemReady.load(std::memory_order_relaxed))
+	{
+		// A pair assigned through the public fields is kept
+		if (mlkem_public_key.empty() || mlkem_private_key.empty())
+		{
+			deriveMLKEMKeys();
+		}
+		keyState.mlkemReady.store(true, std::memory_order_release);
+	}
+}
+
+/**
+  * Generates the random libsodium key pair, once. As before lazy generation, pubkey then
+  * carries the ML-KEM768 public key when there is one.
+  */
+void Wallet::ensureBoxKeys() const
+{
+	if (keyState.boxReady.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	ensureMlkemKeys();
+
+	std::lock_guard<std::mutex> lock(keyState.mutex);
+	if (!keyState.boxReady.load(std::memory_order_relaxed))
+	{
+		if (privkey.empty() || pubkey.empty())
+		{
+			generatePublicAndPrivateKeys(this->privkey, this->pubkey);
+		}
+		if (!mlkem_public_key.empty())
+		{
+			pubkey = mlkem_public_key;
+		}
+		keyState.boxReady.store(true, std::memory_order_release);
+	}
+}
+
+/**
+  * Generates the libsodium key pair and the ML-KEM768 key pair (derived from the wallet key),
+  * unless that already happened. Placeholder recipient/remainder wallets never get here in
+  * Lazy mode.
+  */
+void Wallet::generateKeys() const
+{
+	ensureBoxKeys();
+}
+
+const std::vector<unsigned char> &Wallet::getPrivkey() const
+{
+	ensureBoxKeys();
+	return privkey;
+}
+
+const std::vector<unsigned char> &Wallet::getPubkey() const
+{
+	ensureBoxKeys();
+	return pubkey;
+}
+
+const std::vector<uint8_t> &Wallet::getMlkemPublicKey() const
+{
+	ensureMlkemKeys();
+	return mlkem_public_key;
+}
+
+const std::vector<uint8_t> &Wallet::getMlkemPrivateKey() const
+{
+	ensureMlkemKeys();
+	return mlkem_private_key;
 }
 
 Wallet::~Wallet()
@@ -59,6 +216,8 @@ Wallet::~Wallet()
 
 bool Wallet::generateMyPublicAndPrivateKeys()
 {
+	generateKeys();
+	std::lock_guard<std::mutex> lock(keyState.mutex);
 	return generatePublicAndPrivateKeys(this->privkey, this->pubkey);
 }
 
@@ -71,7 +230,7 @@ bool Wallet::generateMyPublicAndPrivateKeys()
 std::string Wallet::decryptMyMessage(const std::string &encryptedMessage)
 {
 	try {
-		std::string result = decryptMessage(encryptedMessage, this->pubkey, this->privkey);
+		std::string result = decryptMessage(encryptedMessage, getPubkey(), getPrivkey());
 		
 		// Note: The actual decrypted message should not be cleared here as it's the return value
 		// The calling code is responsible for securely handling the decrypted plaintext
@@ -117,25 +276,21 @@ std::string Wallet::generateWalletKey(const std::string &secret, const std::stri
 		// Constant-time addition of secret and position
 		std::string indexedKeyHex = knishio::WalletCrypto::constantTimeHexAdd(secret, position);
 		
-		// Prepare intermediate key sponge
-		std::string intermediateKeySponge;
-		intermediateKeySponge.reserve(indexedKeyHex.length() + token.length());
-		intermediateKeySponge.append(indexedKeyHex);
-
-		if (!token.empty()) {
-			intermediateKeySponge.append(token);
-		}
-
-		// Generate the private key using double SHAKE256 hashing
-		std::string result = shake256Hex(shake256Hex(intermediateKeySponge, 8192), 8192);
+		// Generate the private key using double SHAKE256 hashing, streaming the
+		// indexed key and token without building an intermediate sponge string
+		unsigned char intermediateKey[1024];
+		knishio::Shake256 sponge;
+		sponge.update(indexedKeyHex).update(token);
+		sponge.finalize(intermediateKey);
+
+		sponge.reset();
+		std::string result = sponge.updateHex(intermediateKey).hexDigest(8192);
 		
 		// Securely clear sensitive intermediate values
 		if (!indexedKeyHex.empty()) {
 			sodium_memzero(const_cast<char*>(indexedKeyHex.data()), indexedKeyHex.size());
 		}
-		if (!intermediateKeySponge.empty()) {
-			sodium_memzero(const_cast<char*>(intermediateKeySponge.data()), intermediateKeySponge.size());
-		}
+		sodium_memzero(intermediateKey, sizeof(intermediateKey));
 		
 		return result;
 		
@@ -150,40 +305,43 @@ std::string Wallet::generateWalletKey(const std::string &secret, const std::stri
   */
 std::string Wallet::generateWalletAddress(const std::string &key)
 {
-	// Subdivide private key into 16 fragments of 128 characters each
-	auto keyFragments = chunkSubstr(key, 128);
-
-	// Generating wallet digest
-	std::string digestSponge;
-
-	for (auto &workingFragment : keyFragments)
+	// Subdivide private key into 16 fragments of 128 characters each and run
+	// every fragment through 16 SHAKE256 rounds; the chains are independent and
+	// advance together on the multi-state Keccak kernels
+	const std::string_view keyView(key);
+	std::vector<std::string_view> keyFragments;
+	for (size_t offset = 0; offset < keyView.size(); offset += knishio::WOTS_CHUNK_HEX_LENGTH)
 	{
-		for (int i = 1; i <= 16; i++)
-		{
-			workingFragment = shake256Hex(workingFragment, 512);
-		}
-
-		digestSponge += workingFragment;
+		keyFragments.push_back(keyView.substr(offset, knishio::WOTS_CHUNK_HEX_LENGTH));
 	}
 
+	const std::vector<int> chainSteps(keyFragments.size(), 16);
+	std::string digestSponge(keyFragments.size() * knishio::WOTS_CHUNK_HEX_LENGTH, '\0');
+	digestSponge.resize(knishio::runWotsChains(keyFragments, chainSteps, digestSponge));
+
 	// Producing wallet address
-	return shake256Hex(shake256Hex(digestSponge, 8192), 256);
+	unsigned char digest[1024];
+	knishio::Shake256 sponge;
+	sponge.update(digestSponge).finalize(digest);
+
+	knishio::Shake256 addressSponge;
+	return addressSponge.updateHex(digest).hexDigest(256);
 }
 
 // =============================================================================
 // ML-KEM768 POST-QUANTUM ENCRYPTION (JavaScript SDK Compatibility)
 // =============================================================================
 
-#ifdef HAVE_MLKEM_NATIVE
-extern "C" {
-    // mlkem-native configuration for ML-KEM768
-    #define MLK_CONFIG_API_PARAMETER_SET 768
-    #define MLK_CONFIG_API_NAMESPACE_PREFIX mlkem
-    #include "mlkem_native.h"
+void Wallet::initializeMLKEM() {
+    std::lock_guard<std::mutex> lock(keyState.mutex);
+    deriveMLKEMKeys();
+    keyState.mlkemReady.store(true, std::memory_order_release);
+    if (keyState.boxReady.load(std::memory_order_relaxed) && !mlkem_public_key.empty()) {
+        pubkey = mlkem_public_key;
+    }
 }
-#endif
 
-void Wallet::initializeMLKEM() {
+void Wallet::deriveMLKEMKeys() const {
 #ifdef HAVE_MLKEM_NATIVE
     if (key.empty()) {
         return;
@@ -207,7 +365,7 @@ void Wallet::initializeMLKEM() {
     mlkem_private_key.resize(2400);  // MLKEM768_SECRETKEYBYTES
     
     // Generate deterministic ML-KEM768 keys using mlkem-native
-    int result = crypto_kem_keypair_derand(
+    int result = knishio::mlkem768KeypairDerand(
         mlkem_public_key.data(),
         mlkem_private_key.data(),
         seed_bytes.data()
@@ -217,128 +375,236 @@ void Wallet::initializeMLKEM() {
         throw std::runtime_error("Failed to generate ML-KEM768 keys");
     }
     
-    // Update pubkey to ML-KEM768 public key (Base64 encoded like JavaScript)
-    pubkey = mlkem_public_key;  // Store raw bytes
-    
     // Securely clear seed
     sodium_memzero(seed_bytes.data(), seed_bytes.size());
 #endif
 }
 
-// AES-256-GCM encryption helper (OpenSSL EVP — portable, no AES-NI gate; mirrors C's aes_gcm.c)
-// Format: [IV (12 bytes)][ciphertext][authentication tag (16 bytes)]
-std::vector<uint8_t> Wallet::encryptWithSharedSecret(const std::vector<uint8_t>& message, const std::vector<uint8_t>& shared_secret) {
+namespace {
+
+constexpr size_t MLKEM768_PUBLIC_KEY_SIZE = 1184;
+constexpr size_t MLKEM768_CIPHERTEXT_SIZE = 1088;
+constexpr size_t MLKEM768_SHARED_SECRET_SIZE = 32;
+
+// Seals plaintext into sealed (nonce ‖ ciphertext ‖ tag) under a fresh random nonce; plaintext may
+// already sit in sealed, between the nonce and the tag
+void sealWithRandomNonce(std::span<const uint8_t, 32> key, std::span<const uint8_t> plaintext, std::span<uint8_t> sealed) {
+    // Generate random 12-byte IV (nonce) via OpenSSL CSPRNG
+    if (sealed.size() < knishio::AEAD_NONCE_SIZE
+        || RAND_bytes(sealed.data(), static_cast<int>(knishio::AEAD_NONCE_SIZE)) != 1) {
+        throw std::runtime_error("AES-256-GCM: IV generation failed");
+    }
+    knishio::aeadSeal(key, plaintext, sealed);
+}
+
+std::span<const uint8_t, 32> sharedSecretKey(const std::vector<uint8_t>& shared_secret) {
     if (shared_secret.size() != 32) {
         throw std::invalid_argument("Shared secret must be 32 bytes for AES-256-GCM");
     }
+    return std::span<const uint8_t, 32>(shared_secret.data(), 32);
+}
+
+// Appends `text` as a JSON string literal, escaped exactly as json::dump() escapes it
+void appendJsonString(std::string& out, std::string_view text) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    out.push_back('"');
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out.push_back(HEX[(c >> 4) & 0xf]);
+                    out.push_back(HEX[c & 0xf]);
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
 
-    constexpr size_t IV_SIZE = 12;
-    constexpr size_t TAG_SIZE = 16;
+void appendBase64(std::string& out, std::span<const uint8_t> bytes) {
+    const size_t offset = out.size();
+    out.resize(offset + knishio::base64EncodedLength(bytes.size()));
+    knishio::base64Encode(bytes, out.data() + offset);
+}
 
-    // Generate random 12-byte IV (nonce) via OpenSSL CSPRNG
-    std::vector<uint8_t> iv(IV_SIZE);
-    if (RAND_bytes(iv.data(), static_cast<int>(IV_SIZE)) != 1) {
-        throw std::runtime_error("AES-256-GCM: IV generation failed");
+// Picks the {cipherText, encryptedMessage} entry under one hashShare key out of an envelope map
+// without building a JSON tree
+class EnvelopeMapSax : public json::json_sax_t {
+public:
+    explicit EnvelopeMapSax(const std::string& shareKey) : shareKey_(shareKey) {}
+
+    bool found = false;
+    std::string cipherText;
+    std::string encryptedMessage;
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { return true; }
+    bool number_unsigned(number_unsigned_t) override { return true; }
+    bool number_float(number_float_t, const string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+
+    bool string(string_t& value) override {
+        if (inEntry_ && depth_ == 2) {
+            if (field_ == "cipherText") {
+                cipherText = std::move(value);
+            } else if (field_ == "encryptedMessage") {
+                encryptedMessage = std::move(value);
+            }
+        }
+        return true;
     }
 
-    // Prepare output buffer: [IV (12)][ciphertext][tag (16)]
-    std::vector<uint8_t> output(IV_SIZE + message.size() + TAG_SIZE);
-    std::copy(iv.begin(), iv.end(), output.begin());
+    bool start_object(std::size_t) override {
+        depth_++;
+        if (depth_ == 2 && entryKey_) {
+            inEntry_ = true;
+            found = true;
+        }
+        return true;
+    }
 
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    if (ctx == nullptr) {
-        throw std::runtime_error("AES-256-GCM: failed to allocate cipher context");
+    bool key(string_t& name) override {
+        if (depth_ == 1) {
+            entryKey_ = name == shareKey_;
+        } else if (depth_ == 2) {
+            field_.assign(name);
+        }
+        return true;
     }
 
-    int len = 0;
-    int ciphertext_len = 0;
-    bool ok =
-        EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, nullptr, nullptr) == 1 &&
-        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, static_cast<int>(IV_SIZE), nullptr) == 1 &&
-        EVP_EncryptInit_ex(ctx, nullptr, nullptr, shared_secret.data(), iv.data()) == 1 &&
-        EVP_EncryptUpdate(ctx, output.data() + IV_SIZE, &len, message.data(), static_cast<int>(message.size())) == 1;
-    if (ok) {
-        ciphertext_len = len;
-        ok = EVP_EncryptFinal_ex(ctx, output.data() + IV_SIZE + ciphertext_len, &len) == 1;
-        ciphertext_len += len;
+    bool end_object() override {
+        if (depth_ == 2) {
+            inEntry_ = false;
+        }
+        depth_--;
+        return true;
     }
-    if (ok) {
-        // Append the 16-byte authentication tag after the ciphertext
-        ok = EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, static_cast<int>(TAG_SIZE),
-                                 output.data() + IV_SIZE + ciphertext_len) == 1;
+
+    bool start_array(std::size_t) override {
+        depth_++;
+        return true;
     }
-    EVP_CIPHER_CTX_free(ctx);
 
-    if (!ok) {
-        throw std::runtime_error("AES-256-GCM encryption failed");
+    bool end_array() override {
+        depth_--;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
     }
 
-    // Final layout: [IV (12)][ciphertext][tag (16)]
-    output.resize(IV_SIZE + static_cast<size_t>(ciphertext_len) + TAG_SIZE);
+private:
+    const std::string& shareKey_;
+    int depth_ = 0;
+    bool entryKey_ = false;
+    bool inEntry_ = false;
+    std::string field_;
+};
+
+} // anonymous namespace
+
+// AES-256-GCM encryption helper
+// Format: [IV (12 bytes)][ciphertext][authentication tag (16 bytes)]
+std::vector<uint8_t> Wallet::encryptWithSharedSecret(const std::vector<uint8_t>& message, const std::vector<uint8_t>& shared_secret) {
+    auto aesKey = sharedSecretKey(shared_secret);
+    std::vector<uint8_t> output(knishio::aeadSealedLength(message.size()));
+    sealWithRandomNonce(aesKey, message, output);
     return output;
 }
 
-// AES-256-GCM decryption helper (OpenSSL EVP — portable, no AES-NI gate; mirrors C's aes_gcm.c)
+// AES-256-GCM decryption helper
 // Format: [IV (12 bytes)][ciphertext][authentication tag (16 bytes)]
 std::vector<uint8_t> Wallet::decryptWithSharedSecret(const std::vector<uint8_t>& encrypted_message, const std::vector<uint8_t>& shared_secret) {
-    if (shared_secret.size() != 32) {
-        throw std::invalid_argument("Shared secret must be 32 bytes for AES-256-GCM");
+    auto aesKey = sharedSecretKey(shared_secret);
+    // Minimum size check: nonce + tag (at least 28 bytes)
+    if (encrypted_message.size() < knishio::aeadSealedLength(0)) {
+        throw std::invalid_argument("Encrypted message too short for AES-256-GCM format");
     }
 
-    constexpr size_t IV_SIZE = 12;
-    constexpr size_t TAG_SIZE = 16;
+    std::vector<uint8_t> plaintext(encrypted_message.size() - knishio::aeadSealedLength(0));
+    knishio::aeadOpen(aesKey, encrypted_message, plaintext);
+    return plaintext;
+}
 
-    // Minimum size check: IV + tag (at least 28 bytes)
-    if (encrypted_message.size() < IV_SIZE + TAG_SIZE) {
-        throw std::invalid_argument("Encrypted message too short for AES-256-GCM format");
+std::map<std::string, std::string> Wallet::encryptMessageML768(const std::string& message, const std::string& recipient_pubkey) {
+    uint8_t shared_secret[MLKEM768_SHARED_SECRET_SIZE];
+    std::string cipherText = encapsulateML768(recipient_pubkey, shared_secret);
+
+    // JSON-encode message (cross-SDK compatibility requirement)
+    // Other SDKs (PHP, JavaScript, Kotlin) JSON-encode messages before encryption
+    std::string message_json_str = json(message).dump();
+
+    // Encrypt the JSON-encoded message straight from its string with AES-256-GCM
+    std::vector<uint8_t> encrypted_bytes(knishio::aeadSealedLength(message_json_str.size()));
+    try {
+        sealWithRandomNonce(shared_secret, {reinterpret_cast<const uint8_t*>(message_json_str.data()), message_json_str.size()}, encrypted_bytes);
+    } catch (const std::exception&) {
+        sodium_memzero(shared_secret, sizeof(shared_secret));
+        sodium_memzero(message_json_str.data(), message_json_str.size());
+        throw;
     }
+    std::string encrypted_message = toBase64(encrypted_bytes);
 
-    // Split [IV (12)][ciphertext][tag (16)]
-    const uint8_t* iv = encrypted_message.data();
-    const uint8_t* ciphertext = encrypted_message.data() + IV_SIZE;
-    const size_t ciphertext_len = encrypted_message.size() - IV_SIZE - TAG_SIZE;
-    const uint8_t* tag = encrypted_message.data() + encrypted_message.size() - TAG_SIZE;
+    // Clear shared secret and sensitive data
+    sodium_memzero(shared_secret, sizeof(shared_secret));
+    sodium_memzero(message_json_str.data(), message_json_str.size());
 
-    std::vector<uint8_t> plaintext(ciphertext_len);
+    return {
+        {"cipherText", std::move(cipherText)},
+        {"encryptedMessage", std::move(encrypted_message)}
+    };
+}
 
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    if (ctx == nullptr) {
-        throw std::runtime_error("AES-256-GCM: failed to allocate cipher context");
-    }
+// ML-KEM768 decapsulate + AES-256-GCM decrypt → the RAW decrypted UTF-8 string (no JSON-decode).
+// Shared by decryptMessageML768 (which JSON-decodes the result — the c136 vector + the PQ-transport
+// REQUEST direction encrypt a JSON string value) and decryptMyMessageML768 (the PQ-transport
+// RESPONSE direction, where the validator encrypts the response OBJECT → the raw plaintext is the
+// inner GraphQL response JSON directly). PQ-transport Phase E.
+std::string Wallet::mlkemDecryptToString(const std::map<std::string, std::string>& encrypted_data) {
+    std::string plaintext;
+    openML768(encrypted_data.at("cipherText"), encrypted_data.at("encryptedMessage"), plaintext);
+    return plaintext;
+}
 
-    int len = 0;
-    int plaintext_len = 0;
-    int ret = 0;
-    bool ok =
-        EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, nullptr, nullptr) == 1 &&
-        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, static_cast<int>(IV_SIZE), nullptr) == 1 &&
-        EVP_DecryptInit_ex(ctx, nullptr, nullptr, shared_secret.data(), iv) == 1 &&
-        EVP_DecryptUpdate(ctx, plaintext.data(), &len, ciphertext, static_cast<int>(ciphertext_len)) == 1;
-    if (ok) {
-        plaintext_len = len;
-        // Set the expected authentication tag, then finalize (verifies the tag)
-        ok = EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, static_cast<int>(TAG_SIZE),
-                                 const_cast<uint8_t*>(tag)) == 1;
-    }
-    if (ok) {
-        ret = EVP_DecryptFinal_ex(ctx, plaintext.data() + plaintext_len, &len);
-    }
-    EVP_CIPHER_CTX_free(ctx);
+// Decapsulates the shared secret and decrypts the base64 message into `out`, in place: the
+// message is decoded straight into out's buffer and the plaintext is moved to its front.
+void Wallet::openML768(std::string_view cipherText, std::string_view encryptedMessage, std::string& out) const {
+    uint8_t shared_secret[MLKEM768_SHARED_SECRET_SIZE];
+    decapsulateML768(cipherText, shared_secret);
 
-    if (!ok || ret <= 0) {
-        throw std::runtime_error("AES-256-GCM decryption failed: authentication tag mismatch");
+    out.resize(knishio::base64DecodedMaxLength(encryptedMessage.size()));
+    auto* buffer = reinterpret_cast<uint8_t*>(out.data());
+    size_t length = 0;
+    try {
+        length = knishio::aeadOpenInPlace(shared_secret, {buffer, knishio::base64Decode(encryptedMessage, buffer)});
+    } catch (const std::exception&) {
+        sodium_memzero(shared_secret, sizeof(shared_secret));
+        out.clear();
+        throw;
     }
+    sodium_memzero(shared_secret, sizeof(shared_secret));
 
-    plaintext_len += len;
-    plaintext.resize(static_cast<size_t>(plaintext_len));
-    return plaintext;
+    out.erase(0, knishio::AEAD_NONCE_SIZE);
+    out.resize(length);
 }
 
-std::map<std::string, std::string> Wallet::encryptMessageML768(const std::string& message, const std::string& recipient_pubkey) {
+// ML-KEM768 encapsulation against a base64 public key → the base64 ciphertext; the caller owns
+// (and wipes) the shared secret
+std::string Wallet::encapsulateML768(const std::string& recipient_pubkey, std::span<uint8_t, 32> shared_secret) {
 #ifdef HAVE_MLKEM_NATIVE
-    // Decode recipient public key from Base64
     auto recipient_key_bytes = fromBase64(recipient_pubkey);
-    if (recipient_key_bytes.size() != 1184) {  // MLKEM768_PUBLICKEYBYTES
+    if (recipient_key_bytes.size() != MLKEM768_PUBLIC_KEY_SIZE) {
         // A wrong-length key here almost always means the node did not advertise an ML-KEM public key
         // in its auth `key` field (e.g. a validator predating the PQ-transport build) — give an
         // actionable message, consistent with the other SDKs' encrypt guards.
@@ -348,92 +614,35 @@ std::map<std::string, std::string> Wallet::encryptMessageML768(const std::string
             " bytes, expected 1184 (ML-KEM-768). The node likely did not advertise an ML-KEM public key "
             "(upgrade the validator to a PQ-transport build), or authenticate with encrypt=false.");
     }
-    
-    // Encapsulate to generate shared secret and ciphertext
-    std::vector<uint8_t> ciphertext(1088);      // MLKEM768_CIPHERTEXTBYTES
-    std::vector<uint8_t> shared_secret(32);     // MLKEM768_SHAREDSECRETBYTES
-    
-    int result = crypto_kem_enc(
-        ciphertext.data(),
-        shared_secret.data(), 
-        recipient_key_bytes.data()
-    );
-    
-    if (result != 0) {
+
+    uint8_t ciphertext[MLKEM768_CIPHERTEXT_SIZE];
+    if (knishio::mlkem768Encapsulate(ciphertext, shared_secret.data(), recipient_key_bytes.data()) != 0) {
         throw std::runtime_error("ML-KEM768 encapsulation failed");
     }
-
-    // JSON-encode message (cross-SDK compatibility requirement)
-    // Other SDKs (PHP, JavaScript, Kotlin) JSON-encode messages before encryption
-    json message_json = message;
-    std::string message_json_str = message_json.dump();
-
-    // Encrypt JSON-encoded message with shared secret using AES-256-GCM
-    std::vector<uint8_t> message_bytes(message_json_str.begin(), message_json_str.end());
-    std::vector<uint8_t> encrypted_bytes = encryptWithSharedSecret(message_bytes, shared_secret);
-    std::string encrypted_message = toBase64(encrypted_bytes);
-
-    // Clear shared secret and sensitive data
-    sodium_memzero(shared_secret.data(), shared_secret.size());
-    sodium_memzero(message_bytes.data(), message_bytes.size());
-    sodium_memzero(encrypted_bytes.data(), encrypted_bytes.size());
-
-    return {
-        {"cipherText", toBase64(ciphertext)},
-        {"encryptedMessage", encrypted_message}
-    };
+    return toBase64(std::span<const uint8_t>(ciphertext));
 #else
+    (void)recipient_pubkey;
+    (void)shared_secret;
     throw std::runtime_error("ML-KEM768 not available");
 #endif
 }
 
-// ML-KEM768 decapsulate + AES-256-GCM decrypt → the RAW decrypted UTF-8 string (no JSON-decode).
-// Shared by decryptMessageML768 (which JSON-decodes the result — the c136 vector + the PQ-transport
-// REQUEST direction encrypt a JSON string value) and decryptMyMessageML768 (the PQ-transport
-// RESPONSE direction, where the validator encrypts the response OBJECT → the raw plaintext is the
-// inner GraphQL response JSON directly). PQ-transport Phase E.
-std::string Wallet::mlkemDecryptToString(const std::map<std::string, std::string>& encrypted_data) {
+// Recovers the shared secret of a base64 ML-KEM768 ciphertext with this wallet's private key
+void Wallet::decapsulateML768(std::string_view cipherText, std::span<uint8_t, 32> shared_secret) const {
 #ifdef HAVE_MLKEM_NATIVE
-    auto ciphertext = fromBase64(encrypted_data.at("cipherText"));
-    auto encrypted_message = fromBase64(encrypted_data.at("encryptedMessage"));
-
-    if (ciphertext.size() != 1088) {  // MLKEM768_CIPHERTEXTBYTES
+    std::vector<uint8_t> ciphertext(knishio::base64DecodedMaxLength(cipherText.size()));
+    ciphertext.resize(knishio::base64Decode(cipherText, ciphertext.data()));
+    if (ciphertext.size() != MLKEM768_CIPHERTEXT_SIZE) {
         throw std::invalid_argument("Invalid ML-KEM768 ciphertext size");
     }
 
-    // Decapsulate to recover shared secret
-    std::vector<uint8_t> shared_secret(32);  // MLKEM768_SHAREDSECRETBYTES
-
-    int result = crypto_kem_dec(
-        shared_secret.data(),
-        ciphertext.data(),
-        mlkem_private_key.data()
-    );
-
-    if (result != 0) {
+    if (knishio::mlkem768Decapsulate(shared_secret.data(), ciphertext.data(), getMlkemPrivateKey().data()) != 0) {
         sodium_memzero(shared_secret.data(), shared_secret.size());
         throw std::runtime_error("ML-KEM768 decapsulation failed");
     }
-
-    // Decrypt message with shared secret using AES-256-GCM
-    std::vector<uint8_t> plaintext_bytes;
-    try {
-        plaintext_bytes = decryptWithSharedSecret(encrypted_message, shared_secret);
-    } catch (const std::exception& e) {
-        // Clear shared secret on failure
-        sodium_memzero(shared_secret.data(), shared_secret.size());
-        throw;
-    }
-
-    // Convert decrypted bytes to the raw plaintext string
-    std::string plaintext_json(plaintext_bytes.begin(), plaintext_bytes.end());
-
-    // Clear shared secret and sensitive data
-    sodium_memzero(shared_secret.data(), shared_secret.size());
-    sodium_memzero(plaintext_bytes.data(), plaintext_bytes.size());
-
-    return plaintext_json;
 #else
+    (void)cipherText;
+    (void)shared_secret;
     throw std::runtime_error("ML-KEM768 not available");
 #endif
 }
@@ -463,23 +672,85 @@ std::string Wallet::hashShare(const std::string& pubkeyStr) {
 // { "<hashShare(recipient_pubkey)>": {cipherText, encryptedMessage} }. Matches the Rust validator's
 // CipherHash handler. PQ-transport Phase E.
 std::string Wallet::encryptStringML768(const std::string& message, const std::string& recipient_pubkey) {
-    auto envelope = encryptMessageML768(message, recipient_pubkey);
-    json map;
-    map[hashShare(recipient_pubkey)] = envelope;  // map<string,string> → JSON object
-    return map.dump();
+    std::string envelope;
+    sealStringML768(message, recipient_pubkey, envelope);
+    return envelope;
+}
+
+// Writes the same envelope map as encryptStringML768 straight onto `out`. The message is
+// JSON-encoded (cross-SDK requirement) directly into the buffer it is encrypted in, and the
+// sealed message is base64-encoded straight onto `out`; with `escaped` the map's quotes come out as
+// \" so the map can sit inside a JSON string value (its other characters never need escaping).
+void Wallet::sealStringML768(std::string_view message, const std::string& recipient_pubkey, std::string& out, bool escaped) {
+    uint8_t shared_secret[MLKEM768_SHARED_SECRET_SIZE];
+    const std::string cipherText = encapsulateML768(recipient_pubkey, shared_secret);
+
+    // nonce ‖ JSON-encoded message ‖ tag, sealed in place
+    std::string sealed;
+    sealed.reserve(knishio::aeadSealedLength(message.size() + message.size() / 8 + 2));
+    sealed.resize(knishio::AEAD_NONCE_SIZE);
+    appendJsonString(sealed, message);
+    const size_t length = sealed.size() - knishio::AEAD_NONCE_SIZE;
+    sealed.resize(sealed.size() + knishio::AEAD_TAG_SIZE);
+    try {
+        auto buffer = std::span<uint8_t>(reinterpret_cast<uint8_t*>(sealed.data()), sealed.size());
+        sealWithRandomNonce(shared_secret, buffer.subspan(knishio::AEAD_NONCE_SIZE, length), buffer);
+    } catch (const std::exception&) {
+        sodium_memzero(shared_secret, sizeof(shared_secret));
+        sodium_memzero(sealed.data(), sealed.size());
+        throw;
+    }
+    sodium_memzero(shared_secret, sizeof(shared_secret));
+
+    const std::string_view quote = escaped ? "\\\"" : "\"";
+    out.reserve(out.size() + 128 + cipherText.size() + knishio::base64EncodedLength(sealed.size()));
+    out += '{';
+    out += quote;
+    out += hashShare(recipient_pubkey);
+    out += quote;
+    out += ":{";
+    out += quote;
+    out += "cipherText";
+    out += quote;
+    out += ':';
+    out += quote;
+    out += cipherText;
+    out += quote;
+    out += ',';
+    out += quote;
+    out += "encryptedMessage";
+    out += quote;
+    out += ':';
+    out += quote;
+    appendBase64(out, {reinterpret_cast<const uint8_t*>(sealed.data()), sealed.size()});
+    out += quote;
+    out += "}}";
 }
 
 // Decrypt a CipherHash response map (stringified) addressed to THIS wallet's ML-KEM pubkey
 // (hashShare(base64(mlkem_public_key))) → the RAW inner GraphQL response JSON (NOT json-decoded;
 // it replaces the HTTP response body). Empty string if no entry. PQ-transport Phase E.
 std::string Wallet::decryptMyMessageML768(const std::string& mapJson) {
-    json map = json::parse(mapJson);
-    std::string shareKey = hashShare(toBase64(mlkem_public_key));
-    if (!map.contains(shareKey)) {
+    std::string plaintext;
+    if (!openStringML768(mapJson, plaintext)) {
         return std::string();
     }
-    auto envelope = map.at(shareKey).get<std::map<std::string, std::string>>();
-    return mlkemDecryptToString(envelope);
+    return plaintext;
+}
+
+// Streaming form of decryptMyMessageML768: the map is scanned for this wallet's entry without
+// building a JSON tree, and the plaintext lands in `out`, reusing its capacity
+bool Wallet::openStringML768(std::string_view mapJson, std::string& out) {
+    const std::string shareKey = hashShare(toBase64(getMlkemPublicKey()));
+    EnvelopeMapSax sax(shareKey);
+    if (!json::sax_parse(mapJson.begin(), mapJson.end(), &sax, json::input_format_t::json, true)) {
+        throw std::invalid_argument("Malformed ML-KEM768 envelope map");
+    }
+    if (!sax.found) {
+        return false;
+    }
+    openML768(sax.cipherText, sax.encryptedMessage, out);
+    return true;
 }
 
 // Partition this wallet's tokenUnits across the SENT set (id in `units`) and the KEPT set,
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <cstdint>
@@ -8,13 +12,39 @@
 
 namespace KnishIO {
 
+class WalletCache;
+
 class Wallet
 {
 public:
+	// When the libsodium and ML-KEM768 key pairs are generated: on first access through the
+	// getters (Lazy) or in the constructor (Eager). Process-wide; Lazy by default.
+	enum class KeyGeneration { Lazy, Eager };
+	static void setKeyGeneration(KeyGeneration mode);
+	static KeyGeneration keyGeneration();
+
+	// How a wallet built through a WalletCache uses it: Record restores or derives the wallet and
+	// keeps its entry (a remainder, which the next molecule spends); Spend takes a hit out of the
+	// cache and never records a miss (a source, whose position the chain never derives again)
+	enum class CacheUse { Record, Spend };
+
 	Wallet(const std::string &secret, const std::string &token = "USER", const std::string &position = {}, size_t saltLength = 64);
+	// Same wallet, with key/address/ML-KEM material taken from (and, for Record, kept in) the cache
+	Wallet(const std::string &secret, const std::string &token, const std::string &position, WalletCache &cache,
+		CacheUse use = CacheUse::Record, size_t saltLength = 64);
 	~Wallet();
 
 	bool generateMyPublicAndPrivateKeys();
+	// Generates the key pairs now if they are still pending; no-op otherwise
+	void generateKeys() const;
+	bool hasKeys() const { return keyState.boxReady.load(std::memory_order_acquire); }
+
+	// Key pairs, generated on first access in Lazy mode (thread-safe). The ML-KEM768 getters
+	// only derive the ML-KEM768 pair; getPrivkey()/getPubkey() also generate the libsodium pair.
+	const std::vector<unsigned char> &getPrivkey() const;
+	const std::vector<unsigned char> &getPubkey() const;
+	const std::vector<uint8_t> &getMlkemPublicKey() const;
+	const std::vector<uint8_t> &getMlkemPrivateKey() const;
 	std::string decryptMyMessage(const std::string &message);
 
 	// ML-KEM768 post-quantum cryptography methods (JavaScript SDK compatibility)
@@ -31,7 +61,24 @@ public:
 	std::string decryptMyMessageML768(const std::string& mapJson);
 	std::string mlkemDecryptToString(const std::map<std::string, std::string>& encrypted_data);
 
+	// Buffer-reusing forms of the envelope helpers, for the transport: sealStringML768 appends the
+	// envelope map to `out` (its quotes escaped when it goes inside a JSON string value);
+	// openStringML768 decrypts this wallet's entry into `out`, false when the map has none.
+	void sealStringML768(std::string_view message, const std::string& recipient_pubkey, std::string& out, bool escaped = false);
+	bool openStringML768(std::string_view mapJson, std::string& out);
+
+	// The ML-KEM768 steps under every envelope: encapsulateML768 returns the base64 ciphertext for
+	// a recipient key and fills in the shared secret; decapsulateML768 recovers the shared secret
+	// with this wallet's private key. The caller wipes the secret.
+	static std::string encapsulateML768(const std::string& recipient_pubkey, std::span<uint8_t, 32> shared_secret);
+	void decapsulateML768(std::string_view cipherText, std::span<uint8_t, 32> shared_secret) const;
+
 private:
+	void ensureMlkemKeys() const;
+	void ensureBoxKeys() const;
+	void deriveMLKEMKeys() const;
+	void openML768(std::string_view cipherText, std::string_view encryptedMessage, std::string& out) const;
+
 	// AES-256-GCM helper methods for ML-KEM768 message encryption
 	std::vector<uint8_t> encryptWithSharedSecret(const std::vector<uint8_t>& message, const std::vector<uint8_t>& shared_secret);
 	std::vector<uint8_t> decryptWithSharedSecret(const std::vector<uint8_t>& encrypted_message, const std::vector<uint8_t>& shared_secret);
@@ -53,6 +100,24 @@ public:
 	void splitUnitsMulti(const std::vector<std::vector<std::string>> &recipientUnitLists, std::vector<Wallet> &recipientWallets, Wallet &remainderWallet);
 	std::string getTokenUnitsJson() const;
 
+private:
+	friend class WalletCache;
+
+	// Which lazy key pairs exist. Declared before the keys below so a copy reads the flags
+	// first; the copy gets its own mutex.
+	struct KeyState
+	{
+		std::mutex mutex;
+		std::atomic<bool> mlkemReady{false};
+		std::atomic<bool> boxReady{false};
+
+		KeyState() = default;
+		KeyState(const KeyState &other);
+		KeyState &operator=(const KeyState &other);
+	};
+
+	mutable KeyState keyState;
+
 public:
 	std::string position;
 	std::string token;
@@ -63,12 +128,16 @@ public:
 	std::string molecules;
 	std::string bundle;
 	std::vector<TokenUnit> tokenUnits;   // stackable (NFT) token units carried by this wallet
-	std::vector<unsigned char> privkey;
-	std::vector<unsigned char> pubkey;
+
+	// Deprecated for direct access: read the keys through the getters above, which generate them.
+	// The fields stay empty until a getter, generateKeys() or KeyGeneration::Eager fills them; a
+	// key the caller assigns before then is kept rather than regenerated.
+	mutable std::vector<unsigned char> privkey;
+	mutable std::vector<unsigned char> pubkey;
 
 	// ML-KEM768 post-quantum cryptography keys (JavaScript SDK compatibility)
-	std::vector<uint8_t> mlkem_public_key;
-	std::vector<uint8_t> mlkem_private_key;
+	mutable std::vector<uint8_t> mlkem_public_key;
+	mutable std::vector<uint8_t> mlkem_private_key;
 };
 
 } // namespace KnishIO
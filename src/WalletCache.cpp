@@ -0,0 +1,175 @@
+#include "WalletCache.h"
+
+#include <sodium.h>
+
+#include "Wallet.h"
+
+namespace KnishIO {
+
+WalletCache::WalletCache(size_t capacity)
+	: capacity_(capacity)
+{
+}
+
+WalletCache::~WalletCache()
+{
+	clear();
+}
+
+std::string WalletCache::makeId(std::string_view bundle, std::string_view token, std::string_view position)
+{
+	std::string id;
+	id.reserve(bundle.size() + token.size() + position.size() + 2);
+	id.append(bundle).append(1, '\n').append(token).append(1, '\n').append(position);
+	return id;
+}
+
+std::string WalletCache::makeId(const Wallet &wallet)
+{
+	return makeId(wallet.bundle, wallet.token, wallet.position);
+}
+
+void WalletCache::wipe(Entry &entry)
+{
+	if (!entry.id.empty()) sodium_memzero(entry.id.data(), entry.id.size());
+	if (!entry.key.empty()) sodium_memzero(entry.key.data(), entry.key.size());
+	if (!entry.address.empty()) sodium_memzero(entry.address.data(), entry.address.size());
+	if (!entry.mlkemPublicKey.empty()) sodium_memzero(entry.mlkemPublicKey.data(), entry.mlkemPublicKey.size());
+	if (!entry.mlkemPrivateKey.empty()) sodium_memzero(entry.mlkemPrivateKey.data(), entry.mlkemPrivateKey.size());
+}
+
+bool WalletCache::restore(Wallet &wallet)
+{
+	return lookup(wallet, false);
+}
+
+bool WalletCache::take(Wallet &wallet)
+{
+	return lookup(wallet, true);
+}
+
+bool WalletCache::lookup(Wallet &wallet, bool remove)
+{
+	std::string id = makeId(wallet);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto found = index_.find(id);
+	sodium_memzero(id.data(), id.size());
+
+	if (found == index_.end())
+	{
+		misses_++;
+		return false;
+	}
+
+	hits_++;
+	auto position = found->second;
+	Entry &entry = *position;
+	wallet.key = entry.key;
+	wallet.address = entry.address;
+	wallet.mlkem_public_key = entry.mlkemPublicKey;
+	wallet.mlkem_private_key = entry.mlkemPrivateKey;
+
+	if (remove)
+	{
+		index_.erase(found);
+		wipe(entry);
+		entries_.erase(position);
+	}
+	else
+	{
+		entries_.splice(entries_.begin(), entries_, position);
+	}
+	return true;
+}
+
+void WalletCache::store(const Wallet &wallet)
+{
+	if (capacity_ == 0 || wallet.key.empty())
+	{
+		return;
+	}
+
+	Entry entry{makeId(wallet), wallet.key, wallet.address, wallet.mlkem_public_key, wallet.mlkem_private_key};
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto found = index_.find(entry.id);
+	if (found != index_.end())
+	{
+		// Derived material is deterministic: the existing entry is identical, except that it
+		// may have been recorded before the ML-KEM768 pair was derived
+		Entry &existing = *found->second;
+		if (existing.mlkemPublicKey.empty() && !entry.mlkemPublicKey.empty())
+		{
+			existing.mlkemPublicKey.swap(entry.mlkemPublicKey);
+			existing.mlkemPrivateKey.swap(entry.mlkemPrivateKey);
+		}
+		wipe(entry);
+		return;
+	}
+
+	while (entries_.size() >= capacity_)
+	{
+		evictOldest();
+	}
+
+	entries_.push_front(std::move(entry));
+	index_.emplace(entries_.front().id, entries_.begin());
+}
+
+void WalletCache::erase(std::string_view bundle, std::string_view token, std::string_view position)
+{
+	std::string id = makeId(bundle, token, position);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto found = index_.find(id);
+	sodium_memzero(id.data(), id.size());
+	if (found == index_.end())
+	{
+		return;
+	}
+
+	auto entry = found->second;
+	index_.erase(found);
+	wipe(*entry);
+	entries_.erase(entry);
+}
+
+void WalletCache::evictOldest()
+{
+	Entry &oldest = entries_.back();
+	index_.erase(oldest.id);
+	wipe(oldest);
+	entries_.pop_back();
+}
+
+void WalletCache::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	index_.clear();
+	for (auto &entry : entries_)
+	{
+		wipe(entry);
+	}
+	entries_.clear();
+}
+
+size_t WalletCache::size() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return entries_.size();
+}
+
+uint64_t WalletCache::hits() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return hits_;
+}
+
+uint64_t WalletCache::misses() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return misses_;
+}
+
+} // namespace KnishIO
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace KnishIO {
+
+class Wallet;
+
+/**
+ * class WalletCache
+ *
+ * Bounded LRU cache of derived wallet material, keyed by (bundle, token,
+ * position). A remainder is recorded when it is built and taken out again
+ * when a later molecule spends it as its source. A hit restores the wallet
+ * key and address without re-running generateWalletKey/generateWalletAddress,
+ * and the ML-KEM768 key pair when the recorded wallet had derived it (otherwise
+ * it stays lazy); the libsodium box key pair is random per Wallet and is never
+ * cached.
+ *
+ * Every entry is wiped with sodium_memzero when it is evicted, cleared or the
+ * cache is destroyed. Thread-safe.
+ */
+class WalletCache
+{
+public:
+	explicit WalletCache(size_t capacity);
+	~WalletCache();
+
+	WalletCache(const WalletCache &) = delete;
+	WalletCache &operator=(const WalletCache &) = delete;
+
+	// Fills wallet.key/address/mlkem_* from the entry for wallet.bundle/token/position
+	bool restore(Wallet &wallet);
+	// Like restore, but the entry is wiped and dropped: its position has been spent
+	bool take(Wallet &wallet);
+	// Records the derived material of a freshly constructed wallet; fills in the ML-KEM768
+	// pair of an existing entry that was recorded without it
+	void store(const Wallet &wallet);
+	// Wipes and drops the entry for bundle/token/position, if any: a remainder that will never
+	// be spent (its molecule was not accepted, or its spender was built before it was recorded)
+	void erase(std::string_view bundle, std::string_view token, std::string_view position);
+	void clear();
+
+	size_t size() const;
+	size_t capacity() const { return capacity_; }
+	uint64_t hits() const;
+	uint64_t misses() const;
+
+private:
+	struct Entry
+	{
+		std::string id;		// bundle '\n' token '\n' position
+		std::string key;
+		std::string address;
+		std::vector<uint8_t> mlkemPublicKey;
+		std::vector<uint8_t> mlkemPrivateKey;
+	};
+
+	static std::string makeId(std::string_view bundle, std::string_view token, std::string_view position);
+	static std::string makeId(const Wallet &wallet);
+	static void wipe(Entry &entry);
+	bool lookup(Wallet &wallet, bool remove);
+	void evictOldest();
+
+	size_t capacity_;
+	mutable std::mutex mutex_;
+	std::list<Entry> entries_;		// most recently used first
+	std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;	// views into Entry::id
+	uint64_t hits_ = 0;
+	uint64_t misses_ = 0;
+};
+
+} // namespace KnishIO
@@ -0,0 +1,140 @@
+#include "aead.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <openssl/evp.h>
+#include <sodium.h>
+
+namespace knishio {
+
+namespace {
+
+// One thread's AES-256-GCM context for one direction. The cipher and nonce length are set up
+// once; each message only supplies its key and nonce. The last key schedule stays in the
+// context until the next message rekeys it or the thread exits (freeing cleanses it).
+class ThreadContext {
+public:
+    explicit ThreadContext(int encrypt) : encrypt_(encrypt) {}
+    ~ThreadContext() { discard(); }
+
+    ThreadContext(const ThreadContext&) = delete;
+    ThreadContext& operator=(const ThreadContext&) = delete;
+
+    EVP_CIPHER_CTX* get() {
+        if (ctx_ == nullptr) {
+            ctx_ = EVP_CIPHER_CTX_new();
+            bool ok = ctx_ != nullptr &&
+                EVP_CipherInit_ex(ctx_, EVP_aes_256_gcm(), nullptr, nullptr, nullptr, encrypt_) == 1 &&
+                EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_SET_IVLEN, static_cast<int>(AEAD_NONCE_SIZE), nullptr) == 1;
+            if (!ok) {
+                discard();
+                throw std::runtime_error("AES-256-GCM: failed to allocate cipher context");
+            }
+        }
+        return ctx_;
+    }
+
+    // After a failed message the context's state is unknown; the next one starts over
+    void discard() {
+        EVP_CIPHER_CTX_free(ctx_);
+        ctx_ = nullptr;
+    }
+
+private:
+    int encrypt_;
+    EVP_CIPHER_CTX* ctx_ = nullptr;
+};
+
+ThreadContext& sealContext() {
+    thread_local ThreadContext context(1);
+    return context;
+}
+
+ThreadContext& openContext() {
+    thread_local ThreadContext context(0);
+    return context;
+}
+
+} // anonymous namespace
+
+void aeadSeal(std::span<const uint8_t, AEAD_KEY_SIZE> key, std::span<const uint8_t> plaintext, std::span<uint8_t> sealed) {
+    if (sealed.size() != aeadSealedLength(plaintext.size())) {
+        throw std::invalid_argument("AES-256-GCM: sealed buffer must hold nonce, message and tag");
+    }
+
+    ThreadContext& context = sealContext();
+    EVP_CIPHER_CTX* ctx = context.get();
+    const size_t length = plaintext.size();
+    unsigned char* data = sealed.data() + AEAD_NONCE_SIZE;
+    int len = 0;
+    int ciphertext_len = 0;
+    bool ok =
+        EVP_EncryptInit_ex(ctx, nullptr, nullptr, key.data(), sealed.data()) == 1 &&
+        EVP_EncryptUpdate(ctx, data, &len, plaintext.data(), static_cast<int>(length)) == 1;
+    if (ok) {
+        ciphertext_len = len;
+        ok = EVP_EncryptFinal_ex(ctx, data + ciphertext_len, &len) == 1;
+        ciphertext_len += len;
+    }
+    if (ok) {
+        // GCM is a stream mode: the ciphertext is exactly as long as the plaintext
+        ok = static_cast<size_t>(ciphertext_len) == length &&
+             EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, static_cast<int>(AEAD_TAG_SIZE), data + length) == 1;
+    }
+
+    if (!ok) {
+        context.discard();
+        throw std::runtime_error("AES-256-GCM encryption failed");
+    }
+}
+
+size_t aeadOpen(std::span<const uint8_t, AEAD_KEY_SIZE> key, std::span<const uint8_t> sealed, std::span<uint8_t> plaintext) {
+    // Minimum size check: nonce + tag (at least 28 bytes)
+    if (sealed.size() < aeadSealedLength(0)) {
+        throw std::invalid_argument("Encrypted message too short for AES-256-GCM format");
+    }
+    const size_t length = sealed.size() - aeadSealedLength(0);
+    if (plaintext.size() < length) {
+        throw std::invalid_argument("AES-256-GCM: plaintext buffer too small");
+    }
+
+    ThreadContext& context = openContext();
+    EVP_CIPHER_CTX* ctx = context.get();
+    const unsigned char* data = sealed.data() + AEAD_NONCE_SIZE;
+    // OpenSSL takes the expected tag through a non-const pointer
+    unsigned char tag[AEAD_TAG_SIZE];
+    std::memcpy(tag, data + length, AEAD_TAG_SIZE);
+    int len = 0;
+    int ret = 0;
+    bool ok =
+        EVP_DecryptInit_ex(ctx, nullptr, nullptr, key.data(), sealed.data()) == 1 &&
+        EVP_DecryptUpdate(ctx, plaintext.data(), &len, data, static_cast<int>(length)) == 1 &&
+        // Set the expected authentication tag, then finalize (verifies the tag)
+        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, static_cast<int>(AEAD_TAG_SIZE), tag) == 1;
+    if (ok) {
+        ret = EVP_DecryptFinal_ex(ctx, plaintext.data() + len, &len);
+    }
+
+    if (!ok || ret <= 0) {
+        context.discard();
+        sodium_memzero(plaintext.data(), length);
+        throw std::runtime_error("AES-256-GCM decryption failed: authentication tag mismatch");
+    }
+    return length;
+}
+
+void aeadSealInPlace(std::span<const uint8_t, AEAD_KEY_SIZE> key, std::span<uint8_t> sealed) {
+    if (sealed.size() < aeadSealedLength(0)) {
+        throw std::invalid_argument("AES-256-GCM: sealed buffer must hold nonce, message and tag");
+    }
+    aeadSeal(key, sealed.subspan(AEAD_NONCE_SIZE, sealed.size() - aeadSealedLength(0)), sealed);
+}
+
+size_t aeadOpenInPlace(std::span<const uint8_t, AEAD_KEY_SIZE> key, std::span<uint8_t> sealed) {
+    if (sealed.size() < aeadSealedLength(0)) {
+        throw std::invalid_argument("Encrypted message too short for AES-256-GCM format");
+    }
+    return aeadOpen(key, sealed, sealed.subspan(AEAD_NONCE_SIZE));
+}
+
+} // namespace knishio
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace knishio {
+
+/**
+ * AES-256-GCM over buffers laid out as nonce (12) ‖ data ‖ tag (16)
+ *
+ * The layout every ML-KEM768 envelope uses for its encryptedMessage. Results
+ * are written into the caller's buffers, in place or not (OpenSSL EVP —
+ * portable, no AES-NI gate; mirrors C's aes_gcm.c). Each thread keeps one
+ * cipher context per direction, set up for AES-256-GCM once, so a message
+ * only pays for its key schedule.
+ */
+
+constexpr size_t AEAD_KEY_SIZE = 32;
+constexpr size_t AEAD_NONCE_SIZE = 12;
+constexpr size_t AEAD_TAG_SIZE = 16;
+
+/**
+ * Number of bytes a sealed buffer takes for n bytes of plaintext
+ */
+constexpr size_t aeadSealedLength(size_t n) {
+    return AEAD_NONCE_SIZE + n + AEAD_TAG_SIZE;
+}
+
+/**
+ * Encrypt plaintext into sealed
+ * @param key 32-byte key
+ * @param plaintext Message; either sealed's data bytes themselves or a buffer that does not overlap sealed
+ * @param sealed aeadSealedLength(plaintext.size()) bytes starting with the nonce, already written;
+ *               the ciphertext and tag are written after it
+ * @throws std::invalid_argument if sealed has the wrong size
+ * @throws std::runtime_error if OpenSSL fails
+ */
+void aeadSeal(std::span<const uint8_t, AEAD_KEY_SIZE> key, std::span<const uint8_t> plaintext, std::span<uint8_t> sealed);
+
+/**
+ * Decrypt and authenticate sealed into plaintext
+ * @param key 32-byte key
+ * @param sealed Nonce ‖ ciphertext ‖ tag
+ * @param plaintext At least sealed.size() - 28 bytes; either the ciphertext bytes themselves
+ *                  (sealed.data() + AEAD_NONCE_SIZE) or a buffer that does not overlap sealed
+ * @return Plaintext length
+ * @throws std::invalid_argument if sealed is shorter than nonce + tag or plaintext is too small
+ * @throws std::runtime_error if the tag does not match (the decrypted bytes are wiped)
+ */
+size_t aeadOpen(std::span<const uint8_t, AEAD_KEY_SIZE> key, std::span<const uint8_t> sealed, std::span<uint8_t> plaintext);
+
+/**
+ * aeadSeal of the plaintext already sitting between sealed's nonce and tag
+ */
+void aeadSealInPlace(std::span<const uint8_t, AEAD_KEY_SIZE> key, std::span<uint8_t> sealed);
+
+/**
+ * aeadOpen that leaves the plaintext at sealed.data() + AEAD_NONCE_SIZE
+ * @return Plaintext length
+ */
+size_t aeadOpenInPlace(std::span<const uint8_t, AEAD_KEY_SIZE> key, std::span<uint8_t> sealed);
+
+} // namespace knishio
@@ -0,0 +1,467 @@
+#include "encoding.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#define KNISHIO_ENCODING_X86 1
+#include <immintrin.h>
+#else
+#define KNISHIO_ENCODING_X86 0
+#endif
+
+namespace knishio {
+
+namespace {
+
+constexpr char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// "00".."ff" for every byte value, so each byte is one 2-character copy
+constexpr std::array<char, 512> makeHexPairs() {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 512> table{};
+    for (size_t byte = 0; byte < 256; ++byte) {
+        table[2 * byte] = digits[byte >> 4];
+        table[2 * byte + 1] = digits[byte & 0x0F];
+    }
+    return table;
+}
+
+// Digit value of a hex character, -1 for anything else
+constexpr std::array<int8_t, 256> makeHexValues() {
+    std::array<int8_t, 256> table{};
+    for (size_t c = 0; c < 256; ++c) {
+        table[c] = -1;
+    }
+    for (int8_t d = 0; d < 10; ++d) {
+        table[static_cast<size_t>('0' + d)] = d;
+    }
+    for (int8_t d = 0; d < 6; ++d) {
+        table[static_cast<size_t>('a' + d)] = static_cast<int8_t>(10 + d);
+        table[static_cast<size_t>('A' + d)] = static_cast<int8_t>(10 + d);
+    }
+    return table;
+}
+
+// Sextet value of a base64 character, -1 for anything else (including '=')
+constexpr std::array<int8_t, 256> makeBase64Values() {
+    std::array<int8_t, 256> table{};
+    for (size_t c = 0; c < 256; ++c) {
+        table[c] = -1;
+    }
+    for (int8_t i = 0; i < 64; ++i) {
+        table[static_cast<unsigned char>(BASE64_ALPHABET[i])] = i;
+    }
+    return table;
+}
+
+constexpr std::array<char, 512> HEX_PAIRS = makeHexPairs();
+constexpr std::array<int8_t, 256> HEX_VALUES = makeHexValues();
+constexpr std::array<int8_t, 256> BASE64_VALUES = makeBase64Values();
+
+#if KNISHIO_ENCODING_X86
+
+struct CpuFeatures {
+    bool avx2;
+    bool ssse3;
+};
+
+const CpuFeatures& cpuFeatures() {
+    static const CpuFeatures features{
+        __builtin_cpu_supports("avx2") != 0,
+        __builtin_cpu_supports("ssse3") != 0
+    };
+    return features;
+}
+
+/*
+ * Each kernel handles whole blocks from the start of the input and returns
+ * how many input bytes/characters it consumed; the scalar code finishes the
+ * rest. Decoders stop at the first block containing anything unexpected, so
+ * the scalar code also owns error reporting and the lenient base64 rules.
+ */
+
+// --- hex encode: split nibbles, interleave, map through "0123456789abcdef" ---
+
+__attribute__((target("ssse3")))
+size_t hexEncodeSsse3(const unsigned char* in, size_t length, char* out) {
+    const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble);
+        __m128i lo = _mm_and_si128(bytes, nibble);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_shuffle_epi8(lut, _mm_unpacklo_epi8(hi, lo)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_shuffle_epi8(lut, _mm_unpackhi_epi8(hi, lo)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t hexEncodeAvx2(const unsigned char* in, size_t length, char* out) {
+    const __m256i lut = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                         '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble);
+        __m256i lo = _mm256_and_si256(bytes, nibble);
+        // Unpacks work per 128-bit lane: first holds bytes 0-7 and 16-23, second 8-15 and 24-31
+        __m256i first = _mm256_shuffle_epi8(lut, _mm256_unpacklo_epi8(hi, lo));
+        __m256i second = _mm256_shuffle_epi8(lut, _mm256_unpackhi_epi8(hi, lo));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return i;
+}
+
+// --- hex decode: range-check digits and letters, then merge nibble pairs ---
+
+__attribute__((target("ssse3")))
+size_t hexDecodeSsse3(const char* in, size_t length, unsigned char* out) {
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i letterA = _mm_set1_epi8('a');
+    const __m128i lowerCase = _mm_set1_epi8(0x20);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i five = _mm_set1_epi8(5);
+    const __m128i ten = _mm_set1_epi8(10);
+    const __m128i weights = _mm_set1_epi16(0x0110);  // high nibble * 16 + low nibble
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i digit = _mm_sub_epi8(chars, zero);
+        __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, lowerCase), letterA);
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, nine), digit);
+        __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, five), letter);
+        if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+            break;
+        }
+        __m128i values = _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_andnot_si128(isDigit, _mm_add_epi8(letter, ten)));
+        __m128i words = _mm_maddubs_epi16(values, weights);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i / 2), _mm_packus_epi16(words, words));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t hexDecodeAvx2(const char* in, size_t length, unsigned char* out) {
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i letterA = _mm256_set1_epi8('a');
+    const __m256i lowerCase = _mm256_set1_epi8(0x20);
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i five = _mm256_set1_epi8(5);
+    const __m256i ten = _mm256_set1_epi8(10);
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i digit = _mm256_sub_epi8(chars, zero);
+        __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, lowerCase), letterA);
+        __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, nine), digit);
+        __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, five), letter);
+        if (_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) != -1) {
+            break;
+        }
+        __m256i values = _mm256_blendv_epi8(_mm256_add_epi8(letter, ten), digit, isDigit);
+        __m256i words = _mm256_maddubs_epi16(values, weights);
+        // packus works per lane; gather the low quadword of each lane
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+
+// --- base64 encode (Muła/Lemire): spread 3 bytes over 4 sextets, then map ---
+
+__attribute__((target("ssse3"), always_inline))
+inline __m128i base64Sextets(__m128i bytes) {
+    bytes = _mm_shuffle_epi8(bytes, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+__attribute__((target("ssse3"), always_inline))
+inline __m128i base64Characters(__m128i sextets) {
+    // Offset table indexed by character class: a-z, 0-9 (x10), '+', '/', A-Z
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i classes = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), sextets);
+    classes = _mm_or_si128(classes, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, classes), sextets);
+}
+
+__attribute__((target("ssse3")))
+size_t base64EncodeSsse3(const unsigned char* in, size_t length, char* out) {
+    size_t i = 0;
+    size_t o = 0;
+
+    // 12 bytes per block, but each load reads 16
+    for (; i + 16 <= length; i += 12, o += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), base64Characters(base64Sextets(bytes)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t base64EncodeAvx2(const unsigned char* in, size_t length, char* out) {
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                             'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    size_t i = 0;
+    size_t o = 0;
+
+    // 24 bytes per block (12 per lane); the second lane's load reads 16 bytes at +12
+    for (; i + 28 <= length; i += 24, o += 32) {
+        __m256i bytes = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+        bytes = _mm256_shuffle_epi8(bytes, spread);
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(bytes, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(bytes, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        __m256i sextets = _mm256_or_si256(t0, t1);
+
+        __m256i classes = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+        __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets);
+        classes = _mm256_or_si256(classes, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + o),
+                            _mm256_add_epi8(_mm256_shuffle_epi8(offsets, classes), sextets));
+    }
+    return i;
+}
+
+// --- base64 decode (Muła/Lemire): nibble-table validation, then pack sextets ---
+
+__attribute__((target("ssse3")))
+size_t base64DecodeSsse3(const char* in, size_t length, unsigned char* out) {
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask2F = _mm_set1_epi8(0x2F);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    size_t o = 0;
+
+    for (; i + 16 <= length; i += 16, o += 12) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), mask2F);
+        __m128i lo = _mm_shuffle_epi8(lutLo, _mm_and_si128(chars, mask2F));
+        __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) {
+            break;
+        }
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(chars, mask2F), hiNibbles));
+        __m128i sextets = _mm_add_epi8(chars, roll);
+        __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        alignas(16) unsigned char block[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(block), _mm_shuffle_epi8(merged, pack));
+        std::memcpy(out + o, block, 12);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t base64DecodeAvx2(const char* in, size_t length, unsigned char* out) {
+    const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                           0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                           0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    size_t o = 0;
+
+    for (; i + 32 <= length; i += 32, o += 24) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask2F);
+        __m256i lo = _mm256_shuffle_epi8(lutLo, _mm256_and_si256(chars, mask2F));
+        __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        if (!_mm256_testz_si256(lo, hi)) {
+            break;
+        }
+        __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(chars, mask2F), hiNibbles));
+        __m256i sextets = _mm256_add_epi8(chars, roll);
+        __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        merged = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, pack), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        alignas(32) unsigned char block[32];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(block), merged);
+        std::memcpy(out + o, block, 24);
+    }
+    return i;
+}
+
+#endif // KNISHIO_ENCODING_X86
+
+} // namespace
+
+void hexEncode(std::span<const unsigned char> in, char* out) noexcept {
+    size_t i = 0;
+
+#if KNISHIO_ENCODING_X86
+    if (cpuFeatures().avx2) {
+        i = hexEncodeAvx2(in.data(), in.size(), out);
+    } else if (cpuFeatures().ssse3) {
+        i = hexEncodeSsse3(in.data(), in.size(), out);
+    }
+#endif
+
+    for (; i < in.size(); ++i) {
+        std::memcpy(out + 2 * i, HEX_PAIRS.data() + 2 * in[i], 2);
+    }
+}
+
+size_t hexDecode(std::string_view in, unsigned char* out) {
+    if (in.size() % 2 != 0) {
+        throw std::invalid_argument("Hex string must have even length");
+    }
+
+    size_t i = 0;
+
+#if KNISHIO_ENCODING_X86
+    if (cpuFeatures().avx2) {
+        i = hexDecodeAvx2(in.data(), in.size(), out);
+    } else if (cpuFeatures().ssse3) {
+        i = hexDecodeSsse3(in.data(), in.size(), out);
+    }
+#endif
+
+    for (; i < in.size(); i += 2) {
+        int8_t hi = HEX_VALUES[static_cast<unsigned char>(in[i])];
+        int8_t lo = HEX_VALUES[static_cast<unsigned char>(in[i + 1])];
+        if (hi < 0 || lo < 0) {
+            throw std::invalid_argument("Invalid hex character: " + std::string(1, hi < 0 ? in[i] : in[i + 1]));
+        }
+        out[i / 2] = static_cast<unsigned char>((hi << 4) | lo);
+    }
+
+    return in.size() / 2;
+}
+
+size_t base64Encode(std::span<const unsigned char> in, char* out) noexcept {
+    size_t i = 0;
+
+#if KNISHIO_ENCODING_X86
+    if (cpuFeatures().avx2) {
+        i = base64EncodeAvx2(in.data(), in.size(), out);
+    } else if (cpuFeatures().ssse3) {
+        i = base64EncodeSsse3(in.data(), in.size(), out);
+    }
+#endif
+
+    size_t o = i / 3 * 4;
+
+    for (; i + 3 <= in.size(); i += 3, o += 4) {
+        uint32_t value = (static_cast<uint32_t>(in[i]) << 16) | (static_cast<uint32_t>(in[i + 1]) << 8) | in[i + 2];
+        out[o] = BASE64_ALPHABET[(value >> 18) & 0x3F];
+        out[o + 1] = BASE64_ALPHABET[(value >> 12) & 0x3F];
+        out[o + 2] = BASE64_ALPHABET[(value >> 6) & 0x3F];
+        out[o + 3] = BASE64_ALPHABET[value & 0x3F];
+    }
+
+    if (i < in.size()) {
+        uint32_t value = static_cast<uint32_t>(in[i]) << 16;
+        if (i + 1 < in.size()) {
+            value |= static_cast<uint32_t>(in[i + 1]) << 8;
+        }
+        out[o] = BASE64_ALPHABET[(value >> 18) & 0x3F];
+        out[o + 1] = BASE64_ALPHABET[(value >> 12) & 0x3F];
+        out[o + 2] = i + 1 < in.size() ? BASE64_ALPHABET[(value >> 6) & 0x3F] : '=';
+        out[o + 3] = '=';
+        o += 4;
+    }
+
+    return o;
+}
+
+void base17Encode256(std::span<const unsigned char, 32> value, char* out) noexcept {
+    constexpr char digits[] = "0123456789abcdefg";
+
+    // Most significant limb first
+    uint64_t limbs[4];
+    for (size_t limb = 0; limb < 4; ++limb) {
+        uint64_t v = 0;
+        for (size_t byte = 0; byte < 8; ++byte) {
+            v = (v << 8) | value[limb * 8 + byte];
+        }
+        limbs[limb] = v;
+    }
+
+    // 17^64 > 2^256, so 64 rounds of "divide by 17, keep the remainder" emit
+    // every digit, least significant first. Each limb is divided in two 32-bit
+    // halves so the running remainder (< 17) never overflows 64 bits.
+    for (size_t digit = BASE17_DIGITS_256; digit-- > 0;) {
+        uint64_t remainder = 0;
+        for (auto& limb : limbs) {
+            uint64_t high = (remainder << 32) | (limb >> 32);
+            uint64_t quotientHigh = high / 17;
+            uint64_t low = ((high % 17) << 32) | (limb & 0xFFFFFFFFu);
+            uint64_t quotientLow = low / 17;
+            remainder = low % 17;
+            limb = (quotientHigh << 32) | quotientLow;
+        }
+        out[digit] = digits[remainder];
+    }
+}
+
+size_t base64Decode(std::string_view in, unsigned char* out) noexcept {
+    size_t i = 0;
+
+#if KNISHIO_ENCODING_X86
+    // Kernels only take blocks made entirely of alphabet characters, where the
+    // lenient group rules below reduce to plain decoding
+    if (cpuFeatures().avx2) {
+        i = base64DecodeAvx2(in.data(), in.size(), out);
+    } else if (cpuFeatures().ssse3) {
+        i = base64DecodeSsse3(in.data(), in.size(), out);
+    }
+#endif
+
+    size_t o = i / 4 * 3;
+
+    for (; i < in.size(); i += 4) {
+        uint32_t value = 0;
+        int count = 0;
+
+        for (size_t j = i; j < i + 4 && j < in.size(); ++j) {
+            int8_t sextet = BASE64_VALUES[static_cast<unsigned char>(in[j])];
+            if (sextet < 0) {
+                continue;  // '=' and characters outside the alphabet
+            }
+            value = (value << 6) | static_cast<uint32_t>(sextet);
+            ++count;
+        }
+
+        value <<= (4 - count) * 6;
+
+        for (int j = 0; j < count - 1; ++j) {
+            out[o++] = static_cast<unsigned char>((value >> (16 - j * 8)) & 0xFF);
+        }
+    }
+
+    return o;
+}
+
+} // namespace knishio
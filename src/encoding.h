@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace knishio {
+
+/**
+ * Hex and base64 codecs writing into caller-provided buffers
+ *
+ * These back toHexString()/fromHexString()/toBase64()/fromBase64() in
+ * utility.h and produce exactly the same output. Bulk work runs on AVX2 or
+ * SSSE3 kernels when the CPU has them (checked once at runtime), with
+ * table-driven scalar code for the remainder and for other CPUs. Nothing here
+ * allocates.
+ */
+
+/**
+ * Number of characters hexEncode() writes for n bytes
+ */
+constexpr size_t hexEncodedLength(size_t n) {
+    return n * 2;
+}
+
+/**
+ * Lowercase hex encoding
+ *
+ * Writes exactly 2 * in.size() characters (no terminator).
+ * @param in Bytes to encode
+ * @param out Destination with room for 2 * in.size() characters
+ */
+void hexEncode(std::span<const unsigned char> in, char* out) noexcept;
+
+/**
+ * Hex decoding (upper- or lowercase digits)
+ * @param in Hex text, even length
+ * @param out Destination with room for in.size() / 2 bytes
+ * @return Number of bytes written (in.size() / 2)
+ * @throws std::invalid_argument on odd length or a non-hex character
+ */
+size_t hexDecode(std::string_view in, unsigned char* out);
+
+/**
+ * Number of characters base64Encode() writes for n bytes (padded)
+ */
+constexpr size_t base64EncodedLength(size_t n) {
+    return (n + 2) / 3 * 4;
+}
+
+/**
+ * Upper bound on the bytes base64Decode() writes for n characters
+ */
+constexpr size_t base64DecodedMaxLength(size_t n) {
+    return (n + 3) / 4 * 3;
+}
+
+/**
+ * Standard base64 encoding with '=' padding
+ * @param in Bytes to encode
+ * @param out Destination with room for base64EncodedLength(in.size()) characters
+ * @return Number of characters written
+ */
+size_t base64Encode(std::span<const unsigned char> in, char* out) noexcept;
+
+/**
+ * Base64 decoding, lenient in the same way fromBase64() always was: input is
+ * read in groups of four characters, and '=' or characters outside the
+ * alphabet are skipped within their group
+ * @param in Base64 text
+ * @param out Destination with room for base64DecodedMaxLength(in.size()) bytes
+ * @return Number of bytes written
+ */
+size_t base64Decode(std::string_view in, unsigned char* out) noexcept;
+
+/**
+ * Number of base-17 digits base17Encode256() writes
+ */
+constexpr size_t BASE17_DIGITS_256 = 64;
+
+/**
+ * Fixed-width base-17 encoding of a 256-bit big-endian value (the molecular
+ * hash alphabet "0123456789abcdefg")
+ *
+ * Always writes 64 digits, zero-padded on the left: the same string as
+ * charsetBaseConvert(hex, 16, 17, "0123456789abcdefg") padded to 64
+ * characters, computed on four 64-bit limbs instead of an arbitrary-precision
+ * integer.
+ * @param value 32-byte big-endian value
+ * @param out Destination with room for 64 characters
+ */
+void base17Encode256(std::span<const unsigned char, 32> value, char* out) noexcept;
+
+} // namespace knishio
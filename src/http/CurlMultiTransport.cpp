@@ -0,0 +1,261 @@
+#include "http/CurlMultiTransport.h"
+#include "exception/KnishIOException.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace knishio {
+namespace http {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Timer {
+    Clock::time_point due;
+    uint64_t sequence;                  // keeps equal deadlines in scheduling order
+    CurlMultiTransport::Task task;
+
+    bool operator>(const Timer& other) const {
+        return due != other.due ? due > other.due : sequence > other.sequence;
+    }
+};
+
+// Upper bound on one poll, so a missed wakeup can never stall the loop for long
+constexpr int MAX_POLL_MS = 1000;
+
+} // anonymous namespace
+
+class CurlMultiTransport::Impl {
+public:
+    CURLM* multi = nullptr;
+    std::thread ioThread;
+
+    // Handed over by other threads, picked up by the I/O thread
+    std::mutex queueMutex;
+    std::vector<std::pair<CURL*, Completion>> submissions;
+    std::vector<Timer> newTimers;
+    uint64_t timerSequence = 0;
+    bool stopping = false;
+
+    // Owned by the I/O thread
+    std::unordered_map<CURL*, Completion> running;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers;
+    std::atomic<size_t> activeCount{0};
+    std::atomic<size_t> callbackFailures{0};
+
+    Impl() {
+        multi = curl_multi_init();
+        if (!multi) {
+            throw KnishIOException("Failed to initialize CURL multi handle");
+        }
+        // Concurrent requests to one node become HTTP/2 streams on a shared connection
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    }
+
+    ~Impl() {
+        curl_multi_cleanup(multi);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        curl_multi_wakeup(multi);
+    }
+
+    void takeQueued() {
+        std::vector<std::pair<CURL*, Completion>> added;
+        std::vector<Timer> scheduled;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            added.swap(submissions);
+            scheduled.swap(newTimers);
+        }
+        for (auto& timer : scheduled) {
+            timers.push(std::move(timer));
+        }
+        for (auto& [handle, onDone] : added) {
+            if (curl_multi_add_handle(multi, handle) != CURLM_OK) {
+                finish(handle, std::move(onDone), CURLE_FAILED_INIT);
+                continue;
+            }
+            running.emplace(handle, std::move(onDone));
+        }
+    }
+
+    void runDueTimers() {
+        auto now = Clock::now();
+        while (!timers.empty() && timers.top().due <= now) {
+            auto task = std::move(const_cast<Timer&>(timers.top()).task);
+            timers.pop();
+            runGuarded([&] { task(false); });
+        }
+    }
+
+    void collectFinished() {
+        int queued = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+            CURL* handle = message->easy_handle;
+            CURLcode result = message->data.result;
+            curl_multi_remove_handle(multi, handle);
+
+            auto found = running.find(handle);
+            if (found == running.end()) {
+                continue;
+            }
+            auto onDone = std::move(found->second);
+            running.erase(found);
+            finish(handle, std::move(onDone), result);
+        }
+    }
+
+    void finish(CURL* handle, Completion onDone, CURLcode result) {
+        activeCount--;
+        runGuarded([&] { onDone(handle, result); });
+    }
+
+    // A throwing callback must not take the I/O thread down with it. Callbacks that own a
+    // request settle it themselves (GraphQLClient hands the exception to the caller's future);
+    // anything reaching this point is only counted.
+    template<typename F>
+    void runGuarded(F&& task) {
+        try {
+            task();
+        } catch (...) {
+            callbackFailures++;
+        }
+    }
+
+    int pollTimeout() {
+        long curlTimeout = -1;
+        curl_multi_timeout(multi, &curlTimeout);
+        long timeout = curlTimeout < 0 ? MAX_POLL_MS : std::min<long>(curlTimeout, MAX_POLL_MS);
+        if (!timers.empty()) {
+            auto untilTimer = std::chrono::duration_cast<std::chrono::milliseconds>(
+                timers.top().due - Clock::now()).count();
+            timeout = std::clamp<long>(static_cast<long>(untilTimer), 0, timeout);
+        }
+        return static_cast<int>(timeout);
+    }
+
+    void run() {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (stopping) {
+                    break;
+                }
+            }
+            takeQueued();
+            runDueTimers();
+
+            int stillRunning = 0;
+            curl_multi_perform(multi, &stillRunning);
+            collectFinished();
+
+            curl_multi_poll(multi, nullptr, 0, pollTimeout(), nullptr);
+        }
+
+        // Shutdown: live transfers are aborted and pending timers run cancelled, so every
+        // callback still gets its one call. Those callbacks may queue more work, which is
+        // drained the same way until nothing is left.
+        auto live = std::move(running);
+        running.clear();
+        for (auto& [handle, onDone] : live) {
+            curl_multi_remove_handle(multi, handle);
+            finish(handle, std::move(onDone), CURLE_ABORTED_BY_CALLBACK);
+        }
+        for (;;) {
+            std::vector<std::pair<CURL*, Completion>> late;
+            std::vector<Timer> scheduled;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                late.swap(submissions);
+                scheduled.swap(newTimers);
+            }
+            for (auto& timer : scheduled) {
+                timers.push(std::move(timer));
+            }
+            if (late.empty() && timers.empty()) {
+                break;
+            }
+            for (auto& [handle, onDone] : late) {
+                finish(handle, std::move(onDone), CURLE_ABORTED_BY_CALLBACK);
+            }
+            while (!timers.empty()) {
+                auto task = std::move(const_cast<Timer&>(timers.top()).task);
+                timers.pop();
+                runGuarded([&] { task(true); });
+            }
+        }
+    }
+};
+
+std::shared_ptr<CurlMultiTransport> CurlMultiTransport::shared() {
+    // Created on first use; clients hold a reference, so it outlives every one of them
+    static std::mutex sharedMutex;
+    static std::weak_ptr<CurlMultiTransport> instance;
+
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    auto transport = instance.lock();
+    if (!transport) {
+        transport = std::make_shared<CurlMultiTransport>();
+        instance = transport;
+    }
+    return transport;
+}
+
+CurlMultiTransport::CurlMultiTransport()
+    : pImpl_(std::make_shared<Impl>()) {
+    // The I/O thread holds its own reference: requests keep the transport alive, so the last
+    // reference can go away inside one of its callbacks, on the I/O thread itself
+    pImpl_->ioThread = std::thread([impl = pImpl_] { impl->run(); });
+}
+
+CurlMultiTransport::~CurlMultiTransport() {
+    pImpl_->stop();
+    if (pImpl_->ioThread.get_id() == std::this_thread::get_id()) {
+        // Destroyed from a callback: the loop finishes its shutdown and releases the Impl
+        pImpl_->ioThread.detach();
+    } else {
+        pImpl_->ioThread.join();
+    }
+}
+
+void CurlMultiTransport::submit(CURL* handle, Completion onDone) {
+    pImpl_->activeCount++;
+    {
+        std::lock_guard<std::mutex> lock(pImpl_->queueMutex);
+        pImpl_->submissions.emplace_back(handle, std::move(onDone));
+    }
+    curl_multi_wakeup(pImpl_->multi);
+}
+
+void CurlMultiTransport::schedule(std::chrono::milliseconds delay, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(pImpl_->queueMutex);
+        pImpl_->newTimers.push_back({Clock::now() + delay, pImpl_->timerSequence++, std::move(task)});
+    }
+    curl_multi_wakeup(pImpl_->multi);
+}
+
+size_t CurlMultiTransport::activeTransfers() const {
+    return pImpl_->activeCount.load();
+}
+
+size_t CurlMultiTransport::callbackFailures() const {
+    return pImpl_->callbackFailures.load();
+}
+
+} // namespace http
+} // namespace knishio
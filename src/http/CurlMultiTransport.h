@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <curl/curl.h>
+
+namespace knishio {
+namespace http {
+
+/**
+ * Event-loop HTTP transport on a curl multi handle
+ *
+ * One I/O thread drives every transfer handed to submit(): requests to the
+ * same node share connections, and over HTTP/2 run as concurrent streams on
+ * a single connection (CURLPIPE_MULTIPLEX). Callers wait on their own
+ * futures instead of each parking a thread in curl_easy_perform.
+ *
+ * Completion callbacks and scheduled tasks run on the I/O thread, so they
+ * must not block; they may submit() or schedule() follow-up work. Every
+ * callback runs exactly once, also when the transport shuts down first.
+ * A callback reports its own failures (GraphQLClient settles the request's
+ * future); an exception that escapes one is dropped and counted.
+ *
+ * @note Internal to the SDK; GraphQLClient is the public interface
+ */
+class CurlMultiTransport {
+public:
+    /**
+     * Called on the I/O thread when a transfer ends
+     * @param handle The easy handle given to submit(), already detached from the multi handle
+     * @param result Transfer result (CURLE_OK, a network error, or CURLE_ABORTED_BY_CALLBACK on shutdown)
+     */
+    using Completion = std::function<void(CURL* handle, CURLcode result)>;
+
+    /**
+     * Called on the I/O thread when a scheduled delay has passed
+     * @param cancelled true when the transport shut down before the delay passed
+     */
+    using Task = std::function<void(bool cancelled)>;
+
+    /**
+     * Process-wide transport shared by all GraphQLClient instances
+     */
+    [[nodiscard]] static std::shared_ptr<CurlMultiTransport> shared();
+
+    CurlMultiTransport();
+    ~CurlMultiTransport();
+
+    CurlMultiTransport(const CurlMultiTransport&) = delete;
+    CurlMultiTransport& operator=(const CurlMultiTransport&) = delete;
+
+    /**
+     * Start a transfer
+     * @param handle Fully configured easy handle; the caller keeps ownership
+     * @param onDone Invoked exactly once when the transfer finishes
+     */
+    void submit(CURL* handle, Completion onDone);
+
+    /**
+     * Run a task on the I/O thread after a delay (retry backoff without a sleeping thread)
+     * @param delay Time to wait
+     * @param task Work to run; run with cancelled = true if the transport shuts down first
+     */
+    void schedule(std::chrono::milliseconds delay, Task task);
+
+    /**
+     * Number of transfers currently submitted and not yet completed
+     */
+    [[nodiscard]] size_t activeTransfers() const;
+
+    /**
+     * Number of callbacks that threw instead of reporting their failure
+     */
+    [[nodiscard]] size_t callbackFailures() const;
+
+private:
+    class Impl;
+    std::shared_ptr<Impl> pImpl_;   // shared with the I/O thread
+};
+
+} // namespace http
+} // namespace knishio
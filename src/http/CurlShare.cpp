@@ -0,0 +1,60 @@
+#include "http/CurlShare.h"
+#include "exception/KnishIOException.h"
+#include <array>
+#include <mutex>
+
+namespace knishio {
+namespace http {
+
+class CurlShare::Impl {
+public:
+    CURLSH* share = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> locks;
+
+    Impl() {
+        share = curl_share_init();
+        if (!share) {
+            throw KnishIOException("Failed to initialize CURL share handle");
+        }
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        // Transfers only ever run on the transport's I/O thread, so the connection
+        // cache is never used from two threads at once
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    }
+
+    ~Impl() {
+        curl_share_cleanup(share);
+    }
+
+    static void lock(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+        static_cast<Impl*>(userptr)->locks[static_cast<size_t>(data)].lock();
+    }
+
+    static void unlock(CURL*, curl_lock_data data, void* userptr) {
+        static_cast<Impl*>(userptr)->locks[static_cast<size_t>(data)].unlock();
+    }
+};
+
+std::shared_ptr<CurlShare> CurlShare::shared() {
+    // Lives for the whole process, so TLS sessions and idle connections survive the clients
+    // that created them; never destroyed, so no exit-time ordering against late transfers
+    static auto* instance = new std::shared_ptr<CurlShare>(std::make_shared<CurlShare>());
+    return *instance;
+}
+
+CurlShare::CurlShare()
+    : pImpl_(std::make_unique<Impl>()) {
+}
+
+CurlShare::~CurlShare() = default;
+
+CURLSH* CurlShare::handle() const noexcept {
+    return pImpl_->share;
+}
+
+} // namespace http
+} // namespace knishio
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <curl/curl.h>
+
+namespace knishio {
+namespace http {
+
+/**
+ * Process-wide libcurl share object
+ *
+ * Holds the DNS cache, TLS session cache and connection cache of every
+ * client that opts in (GraphQLClient::setSharedSession), so a new client
+ * pointed at a node another client already talks to resumes its TLS session
+ * and reuses its connection instead of paying a fresh handshake.
+ *
+ * Access is serialized through the share lock callbacks, one mutex per
+ * kind of shared data.
+ *
+ * @note Internal to the SDK; easy handles using the share must be cleaned up
+ *       before the last reference is released
+ */
+class CurlShare {
+public:
+    /**
+     * Process-wide share object; alive while any client holds it
+     */
+    [[nodiscard]] static std::shared_ptr<CurlShare> shared();
+
+    CurlShare();
+    ~CurlShare();
+
+    CurlShare(const CurlShare&) = delete;
+    CurlShare& operator=(const CurlShare&) = delete;
+
+    /**
+     * Handle for CURLOPT_SHARE
+     */
+    [[nodiscard]] CURLSH* handle() const noexcept;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
+
+} // namespace http
+} // namespace knishio
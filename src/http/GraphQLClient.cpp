@@ -1,14 +1,17 @@
 #include "http/GraphQLClient.h"
+#include "http/CurlMultiTransport.h"
+#include "http/CurlShare.h"
 #include "exception/KnishIOException.h"
 #include "third_party/nlohmann/json.hpp"
 #include "Wallet.h"
+#include "CipherSession.h"
 #include <sstream>
-#include <thread>
 #include <mutex>
 #include <atomic>
+#include <exception>
 #include <cstring>
-#include <regex>
 #include <algorithm>
+#include <charconv>
 #include <sodium.h>
 
 namespace knishio {
@@ -17,58 +20,381 @@ namespace http {
 namespace {
 
 // PQ-transport (Phase E): the canonical ML-KEM CipherHash transport query (matches the validator
-// + the other SDKs).
-const char* const CIPHER_HASH_QUERY =
-    "query ( $Hash: String! ) { CipherHash ( Hash: $Hash ) { hash } }";
+// + the other SDKs), as the request body around the envelope: {"query":..., "variables":{"Hash":
+// "<envelope map, as a JSON string>"}}.
+constexpr std::string_view CIPHER_HASH_BODY_PREFIX =
+    R"({"query":"query ( $Hash: String! ) { CipherHash ( Hash: $Hash ) { hash } }","variables":{"Hash":")";
+constexpr std::string_view CIPHER_HASH_BODY_SUFFIX = R"("}})";
+
+// Writes the CipherHash POST body for a serialized request in one pass: the request is encrypted
+// from its buffer and the envelope map is written, already escaped, into the body. With a session
+// the request is sealed under the session's keys instead of a fresh encapsulation, and the
+// returned tag is what its response has to match.
+KnishIO::CipherSession::RequestTag writeCipherHashBody(KnishIO::Wallet& wallet, KnishIO::CipherSession* session,
+                                                       std::string_view requestJson, const std::string& serverPubKey,
+                                                       std::string& body) {
+    KnishIO::CipherSession::RequestTag tag;
+    body.clear();
+    body += CIPHER_HASH_BODY_PREFIX;
+    if (session) {
+        tag = session->sealRequest(requestJson, body, true);
+    } else {
+        wallet.sealStringML768(requestJson, serverPubKey, body, true);
+    }
+    body += CIPHER_HASH_BODY_SUFFIX;
+    return tag;
+}
+
+// Pulls data.CipherHash.hash (the response envelope map) out of a response body without
+// building a JSON tree
+class CipherHashSax : public nlohmann::json::json_sax_t {
+public:
+    std::optional<std::string> hash;
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { return true; }
+    bool number_unsigned(number_unsigned_t) override { return true; }
+    bool number_float(number_float_t, const string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+
+    bool string(string_t& value) override {
+        if (depth_ == 3 && matched_ == 3) {
+            hash = std::move(value);
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        depth_++;
+        return true;
+    }
+
+    bool key(string_t& name) override {
+        // matched_ counts how many levels of data > CipherHash > hash the current path follows
+        static constexpr std::string_view PATH[] = {"data", "CipherHash", "hash"};
+        if (depth_ >= 1 && depth_ <= 3 && matched_ >= depth_ - 1) {
+            matched_ = name == PATH[depth_ - 1] ? depth_ : depth_ - 1;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        leave();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        depth_++;
+        return true;
+    }
+
+    bool end_array() override {
+        leave();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+private:
+    void leave() {
+        depth_--;
+        matched_ = std::min(matched_, depth_);
+    }
+
+    int depth_ = 0;
+    int matched_ = 0;
+};
+
+// Forward-only reader over a GraphQL document: just enough lexing to find the operation type and
+// the first root field, skipping ignored tokens, strings and argument lists on the way.
+class OperationScanner {
+public:
+    explicit OperationScanner(std::string_view text) : text_(text) {}
+
+    // Whitespace, commas, the BOM and # comments are insignificant in GraphQL
+    void skipIgnored() {
+        while (pos_ < text_.size()) {
+            char c = text_[pos_];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',') {
+                pos_++;
+            } else if (c == '#') {
+                while (pos_ < text_.size() && text_[pos_] != '\n' && text_[pos_] != '\r') {
+                    pos_++;
+                }
+            } else if (text_.compare(pos_, 3, "\xEF\xBB\xBF") == 0) {
+                pos_ += 3;
+            } else {
+                break;
+            }
+        }
+    }
+
+    std::string_view name() {
+        size_t begin = pos_;
+        if (pos_ < text_.size() && isNameStart(text_[pos_])) {
+            while (pos_ < text_.size() && isNameContinue(text_[pos_])) {
+                pos_++;
+            }
+        }
+        return text_.substr(begin, pos_ - begin);
+    }
+
+    bool consume(char c) {
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    // Moves past the next '{' outside strings and parentheses (variable definitions, directive
+    // arguments and their default values may contain braces); false when there is none
+    bool enterSelectionSet() {
+        int depth = 0;
+        while (pos_ < text_.size()) {
+            char c = text_[pos_];
+            if (c == '"') {
+                skipString();
+                continue;
+            }
+            if (c == '#') {
+                skipIgnored();
+                continue;
+            }
+            pos_++;
+            if (c == '(') {
+                depth++;
+            } else if (c == ')' && depth > 0) {
+                depth--;
+            } else if (c == '{' && depth == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static bool isNameStart(char c) {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+    }
 
-// Light parse of a GraphQL query → (operation_type, root_field_name), for the CipherHash bypass.
-std::pair<std::string, std::string> parseOperation(const std::string& query) {
-    std::string type = "query";
-    std::smatch m;
-    std::regex opRe(R"(\b(query|mutation|subscription)\b)", std::regex::icase);
-    if (std::regex_search(query, m, opRe)) {
-        type = m[1].str();
-        std::transform(type.begin(), type.end(), type.begin(),
-                       [](unsigned char c) { return static_cast<char>(::tolower(c)); });
+    static bool isNameContinue(char c) {
+        return isNameStart(c) || (c >= '0' && c <= '9');
     }
-    std::string name;
-    auto brace = query.find('{');
-    if (brace != std::string::npos) {
-        std::string rest = query.substr(brace + 1);
-        std::smatch nm;
-        std::regex idRe(R"([A-Za-z_][A-Za-z0-9_]*)");
-        if (std::regex_search(rest, nm, idRe)) {
-            name = nm[0].str();
+
+    // At an opening quote: skips a "string" (with escapes) or a """block string"""
+    void skipString() {
+        if (text_.compare(pos_, 3, "\"\"\"") == 0) {
+            pos_ += 3;
+            while (pos_ < text_.size()) {
+                if (text_.compare(pos_, 4, "\\\"\"\"") == 0) {
+                    pos_ += 4;
+                } else if (text_.compare(pos_, 3, "\"\"\"") == 0) {
+                    pos_ += 3;
+                    return;
+                } else {
+                    pos_++;
+                }
+            }
+            return;
+        }
+        pos_++;
+        while (pos_ < text_.size()) {
+            char c = text_[pos_++];
+            if (c == '\\') {
+                pos_++;
+            } else if (c == '"' || c == '\n') {
+                return;
+            }
         }
     }
-    return {type, name};
+
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return ::tolower(static_cast<unsigned char>(x)) == ::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+bool isProposeMolecule(const GraphQLClient::OperationDescriptor& operation) {
+    return operation.kind == GraphQLClient::OperationDescriptor::Kind::Mutation
+        && operation.rootField == "ProposeMolecule";
+}
+
+// Whether ProposeMolecule variables carry a U-isotope (authorization) molecule
+bool proposesUIsotope(const nlohmann::json& variables) {
+    auto molecule = variables.find("molecule");
+    if (molecule == variables.end() || !molecule->is_object()) return false;
+    auto atoms = molecule->find("atoms");
+    if (atoms == molecule->end() || !atoms->is_array() || atoms->empty()) return false;
+    const auto& first = atoms->front();
+    if (!first.is_object()) return false;
+    auto isotope = first.find("isotope");
+    return isotope != first.end() && isotope->is_string() && isotope->get_ref<const std::string&>() == "U";
+}
+
+// Classifies a request that arrived without a descriptor (raw query strings)
+GraphQLClient::OperationDescriptor describe(const GraphQLClient::Request& request) {
+    auto operation = GraphQLClient::OperationDescriptor::scan(request.query);
+    if (isProposeMolecule(operation) && request.variables.has_value()) {
+        operation.uIsotope = proposesUIsotope(request.variables.value());
+    }
+    return operation;
 }
 
 // Whether an outgoing request should be wrapped in CipherHash. Bypass (plaintext): __schema/
 // ContinuId queries, the AccessToken mutation, and the U-isotope ProposeMolecule (auth bootstrap —
 // the key exchange itself can't be encrypted). Mirrors the validator/other-SDK bypass set.
-bool shouldEncryptRequest(const GraphQLClient::Request& request) {
-    auto op = parseOperation(request.query);
-    const std::string& type = op.first;
-    const std::string& name = op.second;
-    if (type == "query" && (name == "__schema" || name == "ContinuId")) return false;
-    if (type == "mutation" && name == "AccessToken") return false;
-    if (type == "mutation" && name == "ProposeMolecule" && request.variables.has_value()) {
-        const auto& v = request.variables.value();
-        if (v.contains("molecule") && v["molecule"].contains("atoms")
-            && v["molecule"]["atoms"].is_array() && !v["molecule"]["atoms"].empty()) {
-            const auto& a0 = v["molecule"]["atoms"][0];
-            if (a0.contains("isotope") && a0["isotope"].is_string()
-                && a0["isotope"].get<std::string>() == "U") {
-                return false;
-            }
+bool shouldEncryptRequest(const GraphQLClient::OperationDescriptor& operation) {
+    using Kind = GraphQLClient::OperationDescriptor::Kind;
+    const std::string& name = operation.rootField;
+    if (operation.kind == Kind::Query && (name == "__schema" || name == "ContinuId")) return false;
+    if (operation.kind == Kind::Mutation && name == "AccessToken") return false;
+    if (isProposeMolecule(operation) && operation.uIsotope) return false;
+    return true;
+}
+
+// Response bodies are recycled: a finished body keeps its capacity, so the next large wallet
+// list or CipherHash envelope is written into memory that is already there
+class BodyBufferPool {
+public:
+    static BodyBufferPool& instance() {
+        // Never destroyed: responses may be released during static destruction
+        static auto* pool = new BodyBufferPool();
+        return *pool;
+    }
+
+    std::string acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            return {};
         }
+        std::string buffer = std::move(free_.back());
+        free_.pop_back();
+        pooledBytes_ -= buffer.capacity();
+        return buffer;
     }
-    return true;
+
+    void release(std::string&& buffer) noexcept {
+        // Small bodies aren't worth keeping; large ones go back to the allocator
+        if (buffer.capacity() < MIN_CAPACITY || buffer.capacity() > MAX_CAPACITY) {
+            return;
+        }
+        buffer.clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.size() < MAX_BUFFERS && pooledBytes_ + buffer.capacity() <= MAX_POOLED_BYTES) {
+            pooledBytes_ += buffer.capacity();
+            free_.push_back(std::move(buffer));
+        }
+    }
+
+private:
+    static constexpr size_t MAX_BUFFERS = 32;
+    static constexpr size_t MIN_CAPACITY = 4 * 1024;
+    static constexpr size_t MAX_CAPACITY = 512 * 1024;
+    static constexpr size_t MAX_POOLED_BYTES = 4 * 1024 * 1024;  // what a burst leaves resident
+
+    BodyBufferPool() {
+        free_.reserve(MAX_BUFFERS);  // release() never allocates
+    }
+
+    std::mutex mutex_;
+    std::vector<std::string> free_;
+    size_t pooledBytes_ = 0;
+};
+
+// Upper bound on what an advertised Content-Length may reserve up front
+constexpr size_t MAX_BODY_RESERVE = 64 * 1024 * 1024;
+
+std::string_view trimHeaderValue(std::string_view value) {
+    auto first = value.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    auto last = value.find_last_not_of(" \t\r\n");
+    return value.substr(first, last - first + 1);
+}
+
+// The value of one header line if it carries `name` (case-insensitive)
+std::optional<std::string_view> matchHeader(std::string_view line, std::string_view name) {
+    if (line.size() <= name.size() || line[name.size()] != ':' || !equalsIgnoreCase(line.substr(0, name.size()), name)) {
+        return std::nullopt;
+    }
+    return trimHeaderValue(line.substr(name.size() + 1));
 }
 
 } // anonymous namespace
 
+// Request counters; shared with in-flight requests, which may outlive the client
+struct RequestStats {
+    std::atomic<size_t> totalRequests{0};
+    std::atomic<size_t> failedRequests{0};
+    std::atomic<size_t> retryCount{0};
+    std::atomic<bool> lastRequestSucceeded{false};
+};
+
+namespace {
+
+// One request from submission until its future is satisfied. Client settings are copied in at
+// submission, so retries and completions never touch the GraphQLClient itself.
+struct PendingRequest {
+    GraphQLClient::Request request;
+    std::promise<GraphQLClient::Response> promise;
+
+    // Settings snapshot
+    std::string uri;
+    long timeout = 0;
+    bool verbose = false;
+    bool verifySSL = true;
+    std::vector<std::string> headerLines;
+    bool encrypt = false;
+    std::shared_ptr<KnishIO::Wallet> cipherWallet;
+    std::shared_ptr<KnishIO::CipherSession> cipherSession;
+    std::string serverPubKey;
+    GraphQLClient::RetryConfig retryConfig;
+    std::shared_ptr<RequestStats> stats;
+    std::shared_ptr<CurlShare> share;         // outlives the handle, released in the destructor
+    std::shared_ptr<CurlMultiTransport> transport;  // runs every callback; retries outlive the client
+
+    // Retry state
+    int attempt = 0;
+    std::chrono::milliseconds delay{0};
+
+    // Buffers of the attempt in flight
+    CURL* handle = nullptr;
+    curl_slist* headers = nullptr;
+    std::string requestJson;                  // plaintext of an encrypted request
+    std::string postData;
+    std::string responseBody;
+    std::string responseHeaders;
+    bool encryptedRequest = false;
+    KnishIO::CipherSession::RequestTag cipherRequest;  // session and sequence of the attempt in flight
+
+    void releaseTransfer() {
+        if (handle) {
+            curl_easy_cleanup(handle);
+            handle = nullptr;
+        }
+        if (headers) {
+            curl_slist_free_all(headers);
+            headers = nullptr;
+        }
+    }
+
+    ~PendingRequest() {
+        releaseTransfer();
+        BodyBufferPool::instance().release(std::move(responseBody));
+    }
+};
+
+} // anonymous namespace
+
 // Implementation class
 class GraphQLClient::Impl {
 public:
@@ -84,50 +410,112 @@ public:
     bool cipherEnabled = false;
     std::optional<std::string> serverPubKey;        // validator's advertised ML-KEM pubkey (base64)
     std::shared_ptr<KnishIO::Wallet> cipherWallet;  // the AUTH source wallet that decrypts responses
+    // Opt-in session keys; the session exists once both the options and the cipher context are set
+    std::optional<KnishIO::CipherSession::Options> sessionOptions;
+    std::shared_ptr<KnishIO::CipherSession> cipherSession;
 
     // Statistics
     mutable std::mutex statsMutex;
-    std::atomic<size_t> totalRequests{0};
-    std::atomic<size_t> failedRequests{0};
-    std::atomic<size_t> retryCount{0};
-    std::atomic<bool> lastRequestSucceeded{false};
-    
-    // CURL handle pool for thread safety
-    mutable std::mutex curlMutex;
-    std::vector<CURL*> curlHandles;
-    
+    std::shared_ptr<RequestStats> stats = std::make_shared<RequestStats>();
+
+    // Every request runs on the shared curl_multi event loop
+    std::shared_ptr<CurlMultiTransport> transport;
+    // Set when the client opts into the process-wide DNS/TLS session/connection cache
+    std::shared_ptr<CurlShare> share;
+
+    // Called whenever the cipher context or the session options change
+    void resetCipherSession() {
+        cipherSession.reset();
+        if (sessionOptions.has_value() && cipherWallet && serverPubKey.has_value()) {
+            cipherSession = std::make_shared<KnishIO::CipherSession>(cipherWallet, serverPubKey.value(),
+                                                                     sessionOptions.value());
+        }
+    }
+
     Impl(const std::string& uri, long timeout, int maxRetries)
         : uri(uri), timeout(timeout) {
         retryConfig.maxRetries = maxRetries;
     }
-    
-    ~Impl() {
-        // Clean up CURL handles
-        std::lock_guard<std::mutex> lock(curlMutex);
-        for (CURL* handle : curlHandles) {
-            curl_easy_cleanup(handle);
+
+    std::shared_ptr<PendingRequest> snapshot(Request request) const {
+        auto pending = std::make_shared<PendingRequest>();
+        pending->request = std::move(request);
+        pending->uri = uri;
+        pending->timeout = timeout;
+        pending->verbose = verbose;
+        pending->verifySSL = verifySSL;
+
+        pending->headerLines.push_back("Content-Type: application/json");
+        pending->headerLines.push_back("Accept: application/json");
+        // The validator reads the X-Auth-Token header, not Authorization: Bearer — matches the
+        // JS/TS/all-SDK convention.
+        if (authToken.has_value()) {
+            pending->headerLines.push_back("X-Auth-Token: " + authToken.value());
         }
-        curlHandles.clear();
-    }
-    
-    CURL* getCurlHandle() {
-        std::lock_guard<std::mutex> lock(curlMutex);
-        if (!curlHandles.empty()) {
-            CURL* handle = curlHandles.back();
-            curlHandles.pop_back();
-            curl_easy_reset(handle);
-            return handle;
+        for (const auto& [name, value] : customHeaders) {
+            pending->headerLines.push_back(name + ": " + value);
         }
-        return curl_easy_init();
-    }
-    
-    void returnCurlHandle(CURL* handle) {
-        std::lock_guard<std::mutex> lock(curlMutex);
-        curlHandles.push_back(handle);
+
+        pending->encrypt = cipherEnabled && cipherWallet && serverPubKey.has_value();
+        pending->cipherWallet = cipherWallet;
+        if (pending->encrypt) {
+            pending->cipherSession = cipherSession;
+        }
+        pending->serverPubKey = serverPubKey.value_or(std::string{});
+        pending->retryConfig = retryConfig;
+        pending->delay = retryConfig.initialDelay;
+        pending->stats = stats;
+        pending->share = share;
+        pending->transport = transport;
+        return pending;
     }
+
+    static void startAttempt(const std::shared_ptr<PendingRequest>& pending);
+    static void finishAttempt(const std::shared_ptr<PendingRequest>& pending, CURLcode result);
+    static void settle(const std::shared_ptr<PendingRequest>& pending, Response response, bool aborted);
+    static void fail(const std::shared_ptr<PendingRequest>& pending, std::exception_ptr error);
 };
 
 // Response methods
+std::optional<std::string_view> GraphQLClient::Response::header(std::string_view name) const {
+    std::string_view block = rawHeaders;
+    while (!block.empty()) {
+        auto end = block.find('\n');
+        auto line = block.substr(0, end);
+        if (auto value = matchHeader(line, name)) {
+            return value;
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        block.remove_prefix(end + 1);
+    }
+    if (rawHeaders.empty()) {
+        for (const auto& [key, value] : headers) {
+            if (equalsIgnoreCase(key, name)) {
+                return std::string_view(value);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+void GraphQLClient::Response::parseHeaders() {
+    std::string_view block = rawHeaders;
+    while (!block.empty()) {
+        auto end = block.find('\n');
+        auto line = block.substr(0, end);
+        auto colon = line.find(':');
+        if (colon != std::string_view::npos) {
+            headers[std::string(line.substr(0, colon))] = std::string(trimHeaderValue(line.substr(colon + 1)));
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        block.remove_prefix(end + 1);
+    }
+}
+
 nlohmann::json GraphQLClient::Response::toJson() const {
     if (body.empty()) {
         return nlohmann::json();
@@ -141,25 +529,66 @@ nlohmann::json GraphQLClient::Response::toJson() const {
 }
 
 // Request methods
-std::string GraphQLClient::Request::toJsonString() const {
-    nlohmann::json root;
-    root["query"] = query;
-    
-    if (variables.has_value()) {
-        root["variables"] = variables.value();
+GraphQLClient::OperationDescriptor GraphQLClient::OperationDescriptor::scan(std::string_view query) {
+    OperationDescriptor operation;
+    OperationScanner scanner(query);
+    scanner.skipIgnored();
+
+    // A bare selection set is the query shorthand; otherwise the keyword leads the definition
+    if (!scanner.consume('{')) {
+        std::string_view keyword = scanner.name();
+        if (equalsIgnoreCase(keyword, "mutation")) {
+            operation.kind = Kind::Mutation;
+        } else if (equalsIgnoreCase(keyword, "subscription")) {
+            operation.kind = Kind::Subscription;
+        }
+        if (!scanner.enterSelectionSet()) {
+            return operation;
+        }
     }
-    
+
+    scanner.skipIgnored();
+    std::string_view field = scanner.name();
+    scanner.skipIgnored();
+    if (!field.empty() && scanner.consume(':')) {
+        scanner.skipIgnored();
+        field = scanner.name();
+    }
+    operation.rootField = std::string(field);
+    return operation;
+}
+
+GraphQLClient::Request GraphQLClient::Request::prepare(std::string query) {
+    Request request;
+    request.operation = OperationDescriptor::scan(query);
+    request.query = std::move(query);
+    return request;
+}
+
+std::string GraphQLClient::Request::toJsonString() const {
+    // Written member by member, in the sorted key order a json object would print them, so the
+    // variables are dumped where they are instead of being copied into a root object first
+    std::string body = "{";
     if (operationName.has_value()) {
-        root["operationName"] = operationName.value();
+        body += R"("operationName":)";
+        body += nlohmann::json(operationName.value()).dump();
+        body += ',';
     }
-    
-    return root.dump();
+    body += R"("query":)";
+    body += nlohmann::json(query).dump();
+    if (variables.has_value()) {
+        body += R"(,"variables":)";
+        body += variables.value().dump();
+    }
+    body += '}';
+    return body;
 }
 
 // Main class implementation
 GraphQLClient::GraphQLClient(const std::string& uri, long timeout, int maxRetries)
     : pImpl_(std::make_unique<Impl>(uri, timeout, maxRetries)) {
     initializeCurl();
+    pImpl_->transport = CurlMultiTransport::shared();
 }
 
 GraphQLClient::~GraphQLClient() {
@@ -190,255 +619,311 @@ std::future<GraphQLClient::Response> GraphQLClient::query(
     const std::string& query,
     const std::optional<nlohmann::json>& variables) {
     
-    return std::async(std::launch::async, [this, query, variables]() {
-        Request request;
-        request.query = query;
-        request.variables = variables;
-        return executeWithRetry(request);
-    });
+    Request request;
+    request.query = query;
+    request.variables = variables;
+    return submit(std::move(request));
 }
 
 std::future<GraphQLClient::Response> GraphQLClient::mutate(
     const std::string& mutation,
     const std::optional<nlohmann::json>& variables) {
     
-    return std::async(std::launch::async, [this, mutation, variables]() {
-        Request request;
-        request.query = mutation;
-        request.variables = variables;
-        return executeWithRetry(request);
-    });
+    Request request;
+    request.query = mutation;
+    request.variables = variables;
+    return submit(std::move(request));
 }
 
 std::future<GraphQLClient::Response> GraphQLClient::execute(const Request& request) {
-    return std::async(std::launch::async, [this, request]() {
-        return executeWithRetry(request);
-    });
+    return submit(request);
 }
 
-GraphQLClient::Response GraphQLClient::executeWithRetry(const Request& request) {
-    Response lastResponse;
-    auto delay = pImpl_->retryConfig.initialDelay;
-    
-    for (int attempt = 0; attempt <= pImpl_->retryConfig.maxRetries; ++attempt) {
-        if (attempt > 0) {
-            // Wait before retry
-            std::this_thread::sleep_for(delay);
-            
-            // Update delay for next retry (exponential backoff)
-            delay = std::chrono::milliseconds(
-                static_cast<long>(delay.count() * pImpl_->retryConfig.backoffMultiplier)
-            );
-            
-            if (delay > pImpl_->retryConfig.maxDelay) {
-                delay = pImpl_->retryConfig.maxDelay;
-            }
-            
-            pImpl_->retryCount++;
-        }
-        
-        try {
-            lastResponse = executeInternal(request);
-            
-            if (lastResponse.isSuccess()) {
-                pImpl_->lastRequestSucceeded = true;
-                return lastResponse;
-            }
-            
-            // Don't retry on client errors (4xx)
-            if (lastResponse.statusCode >= 400 && lastResponse.statusCode < 500) {
-                pImpl_->failedRequests++;
-                pImpl_->lastRequestSucceeded = false;
-                return lastResponse;
-            }
-            
-        } catch (const std::exception& e) {
-            lastResponse.error = e.what();
-            lastResponse.statusCode = 0;
-        }
-    }
-    
-    pImpl_->failedRequests++;
-    pImpl_->lastRequestSucceeded = false;
-    
-    if (!lastResponse.error.has_value()) {
-        lastResponse.error = "Request failed after " + 
-                            std::to_string(pImpl_->retryConfig.maxRetries) + " retries";
-    }
-    
-    return lastResponse;
+std::future<GraphQLClient::Response> GraphQLClient::execute(Request&& request) {
+    return submit(std::move(request));
 }
 
-// CURL callbacks
-size_t GraphQLClient::writeCallback(char* ptr, size_t size, size_t nmemb, void* userdata) {
-    std::string* response = static_cast<std::string*>(userdata);
-    size_t totalSize = size * nmemb;
-    response->append(ptr, totalSize);
-    return totalSize;
+std::future<GraphQLClient::Response> GraphQLClient::submit(Request request) {
+    auto pending = pImpl_->snapshot(std::move(request));
+    auto future = pending->promise.get_future();
+    Impl::startAttempt(pending);
+    return future;
 }
 
-size_t GraphQLClient::headerCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
-    auto* headers = static_cast<std::unordered_map<std::string, std::string>*>(userdata);
-    size_t totalSize = size * nitems;
-    
-    std::string header(buffer, totalSize);
-    size_t colonPos = header.find(':');
-    
-    if (colonPos != std::string::npos) {
-        std::string name = header.substr(0, colonPos);
-        std::string value = header.substr(colonPos + 1);
-        
-        // Trim whitespace
-        value.erase(0, value.find_first_not_of(" \t\r\n"));
-        value.erase(value.find_last_not_of(" \t\r\n") + 1);
-        
-        (*headers)[name] = value;
+// Builds the easy handle for the next attempt and hands it to the event loop. Runs on the
+// caller's thread for the first attempt and on the I/O thread for retries.
+void GraphQLClient::Impl::startAttempt(const std::shared_ptr<PendingRequest>& pending) {
+    pending->stats->totalRequests++;
+    pending->releaseTransfer();
+    if (pending->responseBody.capacity() == 0) {
+        pending->responseBody = BodyBufferPool::instance().acquire();
     }
-    
-    return totalSize;
-}
+    pending->responseBody.clear();
+    pending->responseHeaders.clear();
 
-void GraphQLClient::setupRequestHeaders(CURL* curl, const Request& request) {
-    struct curl_slist* headers = nullptr;
-    
-    // Add content type
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "Accept: application/json");
-    
-    // Add authorization token if present (the validator reads the X-Auth-Token header,
-    // not Authorization: Bearer — matches the JS/TS/all-SDK convention).
-    if (pImpl_->authToken.has_value()) {
-        std::string authHeader = "X-Auth-Token: " + pImpl_->authToken.value();
-        headers = curl_slist_append(headers, authHeader.c_str());
-    }
-    
-    // Add custom headers
-    for (const auto& [name, value] : pImpl_->customHeaders) {
-        std::string header = name;
-        header += ": ";
-        header += value;
-        headers = curl_slist_append(headers, header.c_str());
+    Response failure;
+    failure.statusCode = 0;
+    try {
+        CURL* curl = curl_easy_init();
+        if (!curl) {
+            throw GraphQLException("Failed to initialize CURL handle");
+        }
+        pending->handle = curl;
+
+        // Set URL
+        curl_easy_setopt(curl, CURLOPT_URL, pending->uri.c_str());
+
+        // Set POST data — PQ-transport Phase E: wrap in the ML-KEM CipherHash envelope when
+        // encryption is enabled and the operation isn't bypassed (the validator decrypts it).
+        // Encrypt the FULL body string (the validator recovers it as a JSON string value → parses
+        // the inner request). Each attempt re-encrypts, as a fresh envelope.
+        pending->encryptedRequest = false;
+        if (pending->encrypt && !pending->request.operation.has_value()) {
+            pending->request.operation = describe(pending->request);   // once; retries reuse it
+        }
+        if (pending->encrypt && shouldEncryptRequest(pending->request.operation.value())) {
+            // Serialized once; each attempt seals it straight into the body
+            if (pending->requestJson.empty()) {
+                pending->requestJson = pending->request.toJsonString();
+            }
+            pending->cipherRequest = writeCipherHashBody(*pending->cipherWallet, pending->cipherSession.get(),
+                                                         pending->requestJson, pending->serverPubKey, pending->postData);
+            pending->encryptedRequest = true;
+        } else if (pending->postData.empty()) {
+            pending->postData = pending->request.toJsonString();
+        }
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, pending->postData.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(pending->postData.length()));
+
+        // Set callbacks
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &pending->responseBody);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, headerCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, pending.get());
+
+        // Set timeout
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, pending->timeout);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, pending->timeout / 3);
+
+        // Set verbose mode
+        curl_easy_setopt(curl, CURLOPT_VERBOSE, pending->verbose ? 1L : 0L);
+
+        // Enable HTTP/2; wait for an existing connection to offer multiplexing rather than
+        // opening a new one for every concurrent request
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+
+        // Follow redirects (max 3)
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 3L);
+
+        // SSL/TLS options (verifySSL=false allows self-signed dev validators)
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, pending->verifySSL ? 1L : 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, pending->verifySSL ? 2L : 0L);
+
+        if (pending->share) {
+            curl_easy_setopt(curl, CURLOPT_SHARE, pending->share->handle());
+        }
+
+        // Set headers
+        for (const auto& line : pending->headerLines) {
+            pending->headers = curl_slist_append(pending->headers, line.c_str());
+        }
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, pending->headers);
+
+        pending->transport->submit(curl, [pending](CURL*, CURLcode result) {
+            try {
+                finishAttempt(pending, result);
+            } catch (...) {
+                fail(pending, std::current_exception());
+            }
+        });
+        return;
+    } catch (const std::exception& e) {
+        failure.error = e.what();
     }
-    
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    pending->releaseTransfer();
+    settle(pending, std::move(failure), false);
 }
 
-GraphQLClient::Response GraphQLClient::executeInternal(const Request& request) {
-    pImpl_->totalRequests++;
-    
-    CURL* curl = pImpl_->getCurlHandle();
-    if (!curl) {
-        throw GraphQLException("Failed to initialize CURL handle");
-    }
-    
-    // Ensure curl handle is returned to pool
-    auto curlCleanup = [this](CURL* handle) {
-        pImpl_->returnCurlHandle(handle);
-    };
-    std::unique_ptr<CURL, decltype(curlCleanup)> curlGuard(curl, curlCleanup);
-    
+void GraphQLClient::Impl::finishAttempt(const std::shared_ptr<PendingRequest>& pending, CURLcode result) {
     Response response;
-    std::string responseBody;
-    std::unordered_map<std::string, std::string> responseHeaders;
-    
-    // Set URL
-    curl_easy_setopt(curl, CURLOPT_URL, pImpl_->uri.c_str());
-    
-    // Set POST data — PQ-transport Phase E: wrap in the ML-KEM CipherHash envelope when encryption
-    // is enabled and the operation isn't bypassed (the validator decrypts it). Encrypt the FULL
-    // body string (the validator recovers it as a JSON string value → parses the inner request).
-    bool encryptedRequest = false;
-    std::string postData;
-    if (pImpl_->cipherEnabled && pImpl_->cipherWallet && pImpl_->serverPubKey.has_value()
-        && shouldEncryptRequest(request)) {
-        std::string envelope = pImpl_->cipherWallet->encryptStringML768(
-            request.toJsonString(), pImpl_->serverPubKey.value());
-        Request wrapped;
-        wrapped.query = CIPHER_HASH_QUERY;
-        wrapped.variables = nlohmann::json{{"Hash", envelope}};
-        postData = wrapped.toJsonString();
-        encryptedRequest = true;
-    } else {
-        postData = request.toJsonString();
-    }
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postData.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, postData.length());
-    
-    // Set callbacks
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, headerCallback);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &responseHeaders);
-    
-    // Set timeout
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, pImpl_->timeout);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, pImpl_->timeout / 3);
-    
-    // Set verbose mode
-    curl_easy_setopt(curl, CURLOPT_VERBOSE, pImpl_->verbose ? 1L : 0L);
-    
-    // Enable HTTP/2
-    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
-    
-    // Follow redirects (max 3)
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 3L);
-    
-    // SSL/TLS options (verifySSL=false allows self-signed dev validators)
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, pImpl_->verifySSL ? 1L : 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, pImpl_->verifySSL ? 2L : 0L);
-    
-    // Set headers
-    setupRequestHeaders(curl, request);
-    
-    // Perform request
-    CURLcode res = curl_easy_perform(curl);
-    
-    if (res != CURLE_OK) {
-        response.statusCode = 0;
-        response.error = "CURL error: " + std::string(curl_easy_strerror(res));
-        return response;
+    response.statusCode = 0;
+
+    if (result != CURLE_OK) {
+        response.error = "CURL error: " + std::string(curl_easy_strerror(result));
+        pending->releaseTransfer();
+        settle(pending, std::move(response), result == CURLE_ABORTED_BY_CALLBACK);
+        return;
     }
-    
+
     // Get HTTP status code
     long httpCode = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+    curl_easy_getinfo(pending->handle, CURLINFO_RESPONSE_CODE, &httpCode);
+    pending->releaseTransfer();
     response.statusCode = static_cast<int>(httpCode);
-    response.body = responseBody;
-    response.headers = responseHeaders;
+    response.body = std::move(pending->responseBody);
+    response.rawHeaders = std::move(pending->responseHeaders);
 
     // PQ-transport Phase E: decrypt the CipherHash response envelope back to the inner GraphQL
     // response JSON (which replaces the body for normal parsing). The validator encrypts the
-    // response OBJECT, so decryptMyMessageML768 returns the raw inner JSON (no JSON-decode).
-    if (encryptedRequest && pImpl_->cipherWallet) {
+    // response OBJECT, so the plaintext is the raw inner JSON (no JSON-decode). The envelope is
+    // picked out of the body without a JSON tree and decrypted into a pooled buffer.
+    if (pending->encryptedRequest && pending->cipherWallet) {
+        std::string decrypted = BodyBufferPool::instance().acquire();
+        bool enveloped = false;  // the body is a CipherHash envelope, whether or not it opens
+        bool opened = false;
         try {
-            nlohmann::json env = nlohmann::json::parse(response.body);
-            if (env.contains("data") && env["data"].is_object()
-                && env["data"].contains("CipherHash") && env["data"]["CipherHash"].is_object()
-                && env["data"]["CipherHash"].contains("hash")
-                && env["data"]["CipherHash"]["hash"].is_string()) {
-                std::string decrypted = pImpl_->cipherWallet->decryptMyMessageML768(
-                    env["data"]["CipherHash"]["hash"].get<std::string>());
-                if (!decrypted.empty()) {
-                    response.body = decrypted;
+            CipherHashSax envelope;
+            if (nlohmann::json::sax_parse(response.body.begin(), response.body.end(), &envelope,
+                                          nlohmann::json::input_format_t::json, true)
+                && envelope.hash.has_value()) {
+                enveloped = true;
+                opened = pending->cipherSession
+                    ? pending->cipherSession->openResponse(envelope.hash.value(), pending->cipherRequest, decrypted)
+                    : pending->cipherWallet->openStringML768(envelope.hash.value(), decrypted);
+                if (opened && !decrypted.empty()) {
+                    std::swap(response.body, decrypted);
                 }
             }
         } catch (const std::exception&) {
-            // Not a CipherHash envelope (e.g. a plaintext error response) — leave body unchanged.
+            // An envelope without an entry that opens for this request — leave body unchanged.
+        }
+        if (!opened) {
+            // The body is still the envelope (or a plaintext error page): never hand it back as the result.
+            // A 2xx that carries nothing usable fails the attempt like a transport error, so it is
+            // retried (on a new session when the validator lost ours) and never reads as a success.
+            response.error = "encrypted response could not be opened (HTTP " + std::to_string(response.statusCode) + ")";
+            if (response.isSuccess()) {
+                response.statusCode = 0;
+            }
+        }
+        // An envelope with no session entry for us (or one that didn't open): the validator may
+        // have lost the session, so the next request starts a new one instead of failing until
+        // rotation. A plaintext error (a 5xx page, a rate limit) says nothing about the session.
+        if (enveloped && !opened && pending->cipherSession) {
+            pending->cipherSession->invalidate(pending->cipherRequest);
+        }
+        BodyBufferPool::instance().release(std::move(decrypted));
+    }
+
+    // Check for GraphQL errors in response; a body that never mentions them (every large wallet
+    // list that succeeded) isn't parsed twice
+    if (response.body.find("\"errors\"") != std::string::npos) {
+        try {
+            nlohmann::json jsonResponse = response.toJson();
+            if (jsonResponse.contains("errors") && jsonResponse["errors"].is_array()) {
+                response.error = jsonResponse["errors"].dump();
+            }
+        } catch (const std::exception&) {
+            // Ignore JSON parsing errors here - the body might not be JSON
         }
     }
 
-    // Check for GraphQL errors in response
+    settle(pending, std::move(response), false);
+}
+
+// Completes the future, or schedules the next attempt with exponential backoff. A retry is a
+// timer on the event loop, not a sleeping thread.
+void GraphQLClient::Impl::settle(const std::shared_ptr<PendingRequest>& pending, Response response, bool aborted) {
+    auto& stats = *pending->stats;
+
+    if (response.isSuccess()) {
+        stats.lastRequestSucceeded = true;
+        pending->promise.set_value(std::move(response));
+        return;
+    }
+
+    // Don't retry on client errors (4xx)
+    if (response.statusCode >= 400 && response.statusCode < 500) {
+        stats.failedRequests++;
+        stats.lastRequestSucceeded = false;
+        pending->promise.set_value(std::move(response));
+        return;
+    }
+
+    if (aborted || pending->attempt >= pending->retryConfig.maxRetries) {
+        stats.failedRequests++;
+        stats.lastRequestSucceeded = false;
+        if (!response.error.has_value()) {
+            response.error = "Request failed after " +
+                             std::to_string(pending->retryConfig.maxRetries) + " retries";
+        }
+        pending->promise.set_value(std::move(response));
+        return;
+    }
+
+    GraphQLClient::recycle(std::move(response));
+    auto delay = pending->delay;
+    pending->attempt++;
+    stats.retryCount++;
+
+    // Update delay for next retry (exponential backoff)
+    pending->delay = std::chrono::milliseconds(
+        static_cast<long>(static_cast<double>(delay.count()) * pending->retryConfig.backoffMultiplier));
+    if (pending->delay > pending->retryConfig.maxDelay) {
+        pending->delay = pending->retryConfig.maxDelay;
+    }
+
+    pending->transport->schedule(delay, [pending](bool cancelled) {
+        try {
+            if (cancelled) {
+                Response shutdown;
+                shutdown.statusCode = 0;
+                shutdown.error = "Request cancelled: HTTP transport shut down before retry";
+                settle(pending, std::move(shutdown), true);
+                return;
+            }
+            startAttempt(pending);
+        } catch (...) {
+            fail(pending, std::current_exception());
+        }
+    });
+}
+
+// A callback that throws hands the exception to the caller's future, unless it is settled already
+void GraphQLClient::Impl::fail(const std::shared_ptr<PendingRequest>& pending, std::exception_ptr error) {
+    pending->releaseTransfer();
     try {
-        nlohmann::json jsonResponse = response.toJson();
-        if (jsonResponse.contains("errors") && jsonResponse["errors"].is_array()) {
-            response.error = jsonResponse["errors"].dump();
+        pending->promise.set_exception(error);
+    } catch (const std::future_error&) {
+    }
+}
+
+// CURL callbacks
+size_t GraphQLClient::writeCallback(char* ptr, size_t size, size_t nmemb, void* userdata) {
+    std::string* response = static_cast<std::string*>(userdata);
+    size_t totalSize = size * nmemb;
+    response->append(ptr, totalSize);
+    return totalSize;
+}
+
+size_t GraphQLClient::headerCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
+    auto* pending = static_cast<PendingRequest*>(userdata);
+    size_t totalSize = size * nitems;
+    std::string_view line(buffer, totalSize);
+
+    // Every response in a redirect chain (or an interim 100 Continue) starts with a status
+    // line; only the final response's headers are kept. They are parsed on lookup.
+    if (line.substr(0, 5) == "HTTP/") {
+        pending->responseHeaders.clear();
+    }
+    pending->responseHeaders.append(line);
+
+    // Size the body buffer once instead of growing it chunk by chunk
+    if (auto length = matchHeader(line, "Content-Length")) {
+        size_t bytes = 0;
+        auto [end, error] = std::from_chars(length->data(), length->data() + length->size(), bytes);
+        if (error == std::errc() && end == length->data() + length->size()) {
+            pending->responseBody.reserve(std::min(bytes, MAX_BODY_RESERVE));
         }
-    } catch (const std::exception&) {
-        // Ignore JSON parsing errors here - the body might not be JSON
     }
-    
-    return response;
+    return totalSize;
+}
+
+void GraphQLClient::recycle(Response&& response) noexcept {
+    BodyBufferPool::instance().release(std::move(response.body));
+    response.body.clear();
 }
 
 void GraphQLClient::setAuthToken(const std::string& token) {
@@ -452,6 +937,16 @@ void GraphQLClient::setEncryption(bool encrypt) {
 void GraphQLClient::setCipherContext(std::shared_ptr<KnishIO::Wallet> wallet, const std::string& serverPubKey) {
     pImpl_->cipherWallet = std::move(wallet);
     pImpl_->serverPubKey = serverPubKey;
+    pImpl_->resetCipherSession();
+}
+
+void GraphQLClient::setCipherSession(size_t maxRequests, std::chrono::seconds maxAge) {
+    if (maxRequests == 0) {
+        pImpl_->sessionOptions.reset();
+    } else {
+        pImpl_->sessionOptions = KnishIO::CipherSession::Options{maxRequests, maxAge};
+    }
+    pImpl_->resetCipherSession();
 }
 
 void GraphQLClient::clearAuthToken() {
@@ -491,18 +986,25 @@ void GraphQLClient::setVerifySSL(bool verify) {
     pImpl_->verifySSL = verify;
 }
 
+void GraphQLClient::setSharedSession(bool share) {
+    pImpl_->share = share ? CurlShare::shared() : nullptr;
+}
+
 bool GraphQLClient::isConnected() const noexcept {
-    return pImpl_->lastRequestSucceeded.load();
+    return pImpl_->stats->lastRequestSucceeded.load();
 }
 
 std::unordered_map<std::string, size_t> GraphQLClient::getStats() const {
     std::lock_guard<std::mutex> lock(pImpl_->statsMutex);
+    const auto& stats = *pImpl_->stats;
+    size_t total = stats.totalRequests.load();
+    size_t failed = stats.failedRequests.load();
     return {
-        {"total_requests", pImpl_->totalRequests.load()},
-        {"failed_requests", pImpl_->failedRequests.load()},
-        {"retry_count", pImpl_->retryCount.load()},
-        {"success_rate", pImpl_->totalRequests > 0 
-            ? (pImpl_->totalRequests - pImpl_->failedRequests) * 100 / pImpl_->totalRequests
+        {"total_requests", total},
+        {"failed_requests", failed},
+        {"retry_count", stats.retryCount.load()},
+        {"success_rate", total > 0 && total >= failed
+            ? (total - failed) * 100 / total
             : 0}
     };
 }
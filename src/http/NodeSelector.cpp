@@ -0,0 +1,248 @@
+#include "http/NodeSelector.h"
+#include "exception/KnishIOException.h"
+#include <mutex>
+#include <random>
+
+namespace knishio {
+namespace http {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Circuit {
+    Closed,     // normal traffic
+    Open,       // rejecting traffic until openUntil
+    HalfOpen    // one probe request in flight
+};
+
+struct Node {
+    std::unique_ptr<GraphQLClient> client;
+    double latencyMs = 0.0;
+    bool measured = false;
+    size_t inFlight = 0;
+    int consecutiveFailures = 0;
+    Circuit circuit = Circuit::Closed;
+    Clock::time_point openUntil;
+};
+
+} // anonymous namespace
+
+class NodeSelector::Impl {
+public:
+    Options options;
+    mutable std::mutex mutex;
+    std::vector<Node> nodes;
+    std::optional<size_t> affinity;
+    std::mt19937 rng{std::random_device{}()};
+
+    // Whether a node may take a request now; an expired open circuit lets exactly one probe through
+    bool eligible(const Node& node, Clock::time_point now) const {
+        switch (node.circuit) {
+            case Circuit::Closed:
+                return true;
+            case Circuit::Open:
+                return now >= node.openUntil;
+            case Circuit::HalfOpen:
+                return false;
+        }
+        return false;
+    }
+
+    // Latency assumed for nodes without a measurement: the mean of the measured ones, or 1 ms
+    // before any response. Unmeasured nodes still get sampled early, but their load counts.
+    double priorLatency() const {
+        double total = 0.0;
+        size_t measured = 0;
+        for (const auto& node : nodes) {
+            if (node.measured) {
+                total += node.latencyMs;
+                measured++;
+            }
+        }
+        return measured > 0 ? total / static_cast<double>(measured) : 1.0;
+    }
+
+    // Expected wait on a node
+    static double score(const Node& node, double prior) {
+        return (node.measured ? node.latencyMs : prior) * static_cast<double>(node.inFlight + 1);
+    }
+
+    size_t choose() {
+        auto now = Clock::now();
+        if (affinity.has_value()) {
+            return *affinity;
+        }
+
+        std::vector<size_t> candidates;
+        candidates.reserve(nodes.size());
+        for (size_t index = 0; index < nodes.size(); index++) {
+            if (eligible(nodes[index], now)) {
+                candidates.push_back(index);
+            }
+        }
+
+        if (candidates.empty()) {
+            // Every circuit is open: try the node that will recover first rather than failing outright
+            size_t best = 0;
+            for (size_t index = 1; index < nodes.size(); index++) {
+                if (nodes[index].openUntil < nodes[best].openUntil) {
+                    best = index;
+                }
+            }
+            return best;
+        }
+        if (candidates.size() == 1) {
+            return candidates[0];
+        }
+
+        // Power of two choices
+        std::uniform_int_distribution<size_t> dist(0, candidates.size() - 1);
+        size_t first = dist(rng);
+        size_t second = dist(rng);
+        while (second == first) {
+            second = dist(rng);
+        }
+        size_t a = candidates[first];
+        size_t b = candidates[second];
+        double prior = priorLatency();
+        double scoreA = score(nodes[a], prior);
+        double scoreB = score(nodes[b], prior);
+        if (scoreA == scoreB) {
+            return nodes[b].inFlight < nodes[a].inFlight ? b : a;
+        }
+        return scoreB < scoreA ? b : a;
+    }
+
+    void recordLocked(Node& node, std::chrono::microseconds latency, bool success) {
+        if (!success) {
+            node.consecutiveFailures++;
+            if (node.circuit == Circuit::HalfOpen || node.consecutiveFailures >= options.failureThreshold) {
+                node.circuit = Circuit::Open;
+                node.openUntil = Clock::now() + options.openDuration;
+            }
+            return;
+        }
+
+        double sample = static_cast<double>(latency.count()) / 1000.0;
+        node.latencyMs = node.measured
+            ? options.latencyAlpha * sample + (1.0 - options.latencyAlpha) * node.latencyMs
+            : sample;
+        node.measured = true;
+        node.consecutiveFailures = 0;
+        node.circuit = Circuit::Closed;
+    }
+};
+
+// Lease
+
+NodeSelector::Lease::Lease(NodeSelector* selector, size_t node)
+    : selector_(selector), node_(node), started_(Clock::now()) {
+}
+
+NodeSelector::Lease::Lease(Lease&& other) noexcept
+    : selector_(other.selector_), node_(other.node_), started_(other.started_) {
+    other.selector_ = nullptr;
+}
+
+NodeSelector::Lease::~Lease() {
+    if (selector_) {
+        selector_->release(node_, std::chrono::microseconds(0), false);
+    }
+}
+
+GraphQLClient& NodeSelector::Lease::client() const {
+    return selector_->client(node_);
+}
+
+void NodeSelector::Lease::complete(const GraphQLClient::Response& response) {
+    if (!selector_) {
+        return;
+    }
+    bool success = response.statusCode > 0 && response.statusCode < 500;
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started_);
+    selector_->release(node_, latency, success);
+    selector_ = nullptr;
+}
+
+// NodeSelector
+
+NodeSelector::NodeSelector(const std::vector<std::string>& uris, long timeout, int maxRetries, Options options)
+    : pImpl_(std::make_unique<Impl>()) {
+    if (uris.empty()) {
+        throw KnishIOException("NodeSelector requires at least one URI");
+    }
+    pImpl_->options = options;
+    pImpl_->nodes.resize(uris.size());
+    for (size_t index = 0; index < uris.size(); index++) {
+        pImpl_->nodes[index].client = std::make_unique<GraphQLClient>(uris[index], timeout, maxRetries);
+    }
+}
+
+NodeSelector::NodeSelector(const std::vector<std::string>& uris, long timeout, int maxRetries)
+    : NodeSelector(uris, timeout, maxRetries, Options{}) {
+}
+
+NodeSelector::~NodeSelector() = default;
+
+NodeSelector::Lease NodeSelector::acquire() {
+    std::lock_guard<std::mutex> lock(pImpl_->mutex);
+    size_t index = pImpl_->choose();
+    Node& node = pImpl_->nodes[index];
+    if (node.circuit == Circuit::Open) {
+        node.circuit = Circuit::HalfOpen;
+    }
+    node.inFlight++;
+    return Lease(this, index);
+}
+
+void NodeSelector::record(size_t node, std::chrono::microseconds latency, bool success) {
+    std::lock_guard<std::mutex> lock(pImpl_->mutex);
+    pImpl_->recordLocked(pImpl_->nodes.at(node), latency, success);
+}
+
+void NodeSelector::release(size_t node, std::chrono::microseconds latency, bool success) {
+    std::lock_guard<std::mutex> lock(pImpl_->mutex);
+    Node& entry = pImpl_->nodes[node];
+    entry.inFlight--;
+    pImpl_->recordLocked(entry, latency, success);
+}
+
+void NodeSelector::setAffinity(std::optional<size_t> node) {
+    std::lock_guard<std::mutex> lock(pImpl_->mutex);
+    if (node.has_value() && *node >= pImpl_->nodes.size()) {
+        throw KnishIOException("Node index out of range");
+    }
+    pImpl_->affinity = node;
+}
+
+void NodeSelector::forEachClient(const std::function<void(GraphQLClient&)>& apply) {
+    std::lock_guard<std::mutex> lock(pImpl_->mutex);
+    for (auto& node : pImpl_->nodes) {
+        apply(*node.client);
+    }
+}
+
+GraphQLClient& NodeSelector::client(size_t node) {
+    return *pImpl_->nodes.at(node).client;
+}
+
+size_t NodeSelector::size() const noexcept {
+    return pImpl_->nodes.size();
+}
+
+std::vector<NodeSelector::NodeStats> NodeSelector::getStats() const {
+    std::lock_guard<std::mutex> lock(pImpl_->mutex);
+    auto now = Clock::now();
+    std::vector<NodeStats> stats;
+    stats.reserve(pImpl_->nodes.size());
+    for (const auto& node : pImpl_->nodes) {
+        stats.push_back({node.client->getUri(), node.latencyMs, node.inFlight,
+                         node.consecutiveFailures,
+                         node.circuit == Circuit::Closed || pImpl_->eligible(node, now)});
+    }
+    return stats;
+}
+
+} // namespace http
+} // namespace knishio
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "http/GraphQLClient.h"
+
+namespace knishio {
+namespace http {
+
+/**
+ * Health-aware routing across the configured validator nodes
+ *
+ * Owns one GraphQLClient per node and tracks, per node, an EWMA of request
+ * latency, the number of requests in flight and consecutive failures. Each
+ * request goes to the better of two randomly drawn healthy nodes
+ * (power-of-two-choices), scored by latency weighted with the in-flight count,
+ * so slow or busy validators receive proportionally less traffic. A node with
+ * no response yet is scored with the mean latency of the measured nodes.
+ *
+ * A node that fails failureThreshold times in a row has its circuit opened:
+ * it receives no traffic for openDuration, after which a single probe request
+ * decides whether it rejoins the pool. Transport errors and 5xx responses
+ * count as failures; 4xx responses mean the node is up.
+ *
+ * Thread-safe.
+ */
+class NodeSelector {
+public:
+    /**
+     * Routing parameters
+     */
+    struct Options {
+        double latencyAlpha = 0.2;                        ///< EWMA weight of the newest latency sample
+        int failureThreshold = 3;                         ///< Consecutive failures that open a node's circuit
+        std::chrono::milliseconds openDuration{10000};    ///< How long an open circuit rejects traffic
+    };
+
+    /**
+     * Snapshot of one node's routing state
+     */
+    struct NodeStats {
+        std::string uri;
+        double latencyMs;                                 ///< Latency EWMA (0 until the first response)
+        size_t inFlight;                                  ///< Requests currently routed to the node
+        int consecutiveFailures;
+        bool available;                                   ///< False while the circuit is open
+    };
+
+    /**
+     * One request routed to a node; counts as in flight until completed or destroyed
+     */
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /**
+         * Releases the node; a lease never completed is recorded as a failure
+         */
+        ~Lease();
+
+        /**
+         * The node's client; only until complete(), after which node() still names it
+         */
+        [[nodiscard]] GraphQLClient& client() const;
+        [[nodiscard]] size_t node() const noexcept { return node_; }
+
+        /**
+         * Record the outcome of the request and release the node
+         * @param response The response received from the node
+         */
+        void complete(const GraphQLClient::Response& response);
+
+    private:
+        friend class NodeSelector;
+        Lease(NodeSelector* selector, size_t node);
+
+        NodeSelector* selector_;
+        size_t node_;
+        std::chrono::steady_clock::time_point started_;
+    };
+
+    /**
+     * Constructor
+     * @param uris Node URIs (at least one)
+     * @param timeout Request timeout in milliseconds for every node client
+     * @param maxRetries Retry attempts for every node client
+     * @param options Routing parameters
+     */
+    NodeSelector(const std::vector<std::string>& uris, long timeout, int maxRetries, Options options);
+    NodeSelector(const std::vector<std::string>& uris, long timeout, int maxRetries);
+    ~NodeSelector();
+
+    NodeSelector(const NodeSelector&) = delete;
+    NodeSelector& operator=(const NodeSelector&) = delete;
+
+    /**
+     * Route a request to the best available node
+     * @return Lease on the chosen node
+     */
+    [[nodiscard]] Lease acquire();
+
+    /**
+     * Record a finished request
+     * @param node Node index
+     * @param latency Time from sending the request to its response
+     * @param success False for transport errors and 5xx responses
+     */
+    void record(size_t node, std::chrono::microseconds latency, bool success);
+
+    /**
+     * Pin all traffic to one node (e.g. the holder of a session's cipher context), or unpin
+     * @param node Node index, or std::nullopt to route freely
+     */
+    void setAffinity(std::optional<size_t> node);
+
+    /**
+     * Apply a setting (auth token, TLS options, ...) to every node client
+     * @param apply Called once per node client, with the selector locked; must not call back into it
+     */
+    void forEachClient(const std::function<void(GraphQLClient&)>& apply);
+
+    [[nodiscard]] GraphQLClient& client(size_t node);
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] std::vector<NodeStats> getStats() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+
+    void release(size_t node, std::chrono::microseconds latency, bool success);
+};
+
+} // namespace http
+} // namespace knishio
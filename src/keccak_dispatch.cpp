@@ -0,0 +1,405 @@
+#include "keccak_dispatch.h"
+
+#include "third_party/Keccak/Keccak.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#define KNISHIO_KECCAK_X86 1
+#else
+#define KNISHIO_KECCAK_X86 0
+#endif
+
+#if KNISHIO_KECCAK_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KNISHIO_KECCAK_INLINE inline __attribute__((always_inline))
+#else
+#define KNISHIO_KECCAK_INLINE inline
+#endif
+
+namespace knishio {
+
+namespace {
+
+using PermuteFn = void (*)(void*);
+
+constexpr uint64_t ROUND_CONSTANTS[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+    0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+// ρ rotation offsets, indexed by lane x + 5y
+constexpr int RHO[25] = {
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14
+};
+
+// π destination of lane (x, y): (y, 2x + 3y)
+constexpr int piDestination(int lane) {
+    int x = lane % 5;
+    int y = lane / 5;
+    return y + 5 * ((2 * x + 3 * y) % 5);
+}
+
+/**
+ * Keccak-f[1600] on 25 native 64-bit lanes. Loops have constant bounds and
+ * constant rotation amounts so the compiler fully unrolls each round and
+ * keeps the lanes in registers.
+ */
+KNISHIO_KECCAK_INLINE void permuteLanes(uint64_t* a) {
+    for (int round = 0; round < 24; ++round) {
+        uint64_t c[5];
+        uint64_t d[5];
+        uint64_t b[25];
+
+        // θ
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; ++x) {
+            c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        }
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; ++x) {
+            d[x] = c[(x + 4) % 5] ^ std::rotl(c[(x + 1) % 5], 1);
+        }
+
+        // ρ and π
+#pragma GCC unroll 25
+        for (int lane = 0; lane < 25; ++lane) {
+            b[piDestination(lane)] = std::rotl(a[lane] ^ d[lane % 5], RHO[lane]);
+        }
+
+        // χ
+#pragma GCC unroll 5
+        for (int y = 0; y < 25; y += 5) {
+#pragma GCC unroll 5
+            for (int x = 0; x < 5; ++x) {
+                a[y + x] = b[y + x] ^ (~b[y + (x + 1) % 5] & b[y + (x + 2) % 5]);
+            }
+        }
+
+        // ι
+        a[0] ^= ROUND_CONSTANTS[round];
+    }
+}
+
+void permuteReference(void* state) {
+    KeccakF1600_StatePermute(state);
+}
+
+void permuteOpt64(void* state) {
+    uint64_t lanes[25];
+    std::memcpy(lanes, state, sizeof(lanes));
+    permuteLanes(lanes);
+    std::memcpy(state, lanes, sizeof(lanes));
+}
+
+#if KNISHIO_KECCAK_X86
+// Same code compiled with BMI enabled: χ becomes ANDN and rotations RORX
+__attribute__((target("bmi,bmi2")))
+void permuteLanesBmi2(uint64_t* lanes) {
+    permuteLanes(lanes);
+}
+
+__attribute__((target("bmi,bmi2")))
+void permuteOpt64Bmi2(void* state) {
+    uint64_t lanes[25];
+    std::memcpy(lanes, state, sizeof(lanes));
+    permuteLanes(lanes);
+    std::memcpy(state, lanes, sizeof(lanes));
+}
+
+/*
+ * Multi-state kernels. Register j holds lane j of 4 (AVX2) or 8 (AVX-512)
+ * independent states, so one pass through the rounds permutes all of them.
+ * The structure mirrors permuteLanes() step for step.
+ */
+
+__attribute__((target("avx2"), always_inline))
+inline __m256i rotlX4(__m256i v, int n) {
+    return _mm256_or_si256(_mm256_slli_epi64(v, n), _mm256_srli_epi64(v, 64 - n));
+}
+
+__attribute__((target("avx2")))
+void permuteX4Avx2(uint64_t* lanes) {
+    __m256i a[25];
+    for (int lane = 0; lane < 25; ++lane) {
+        a[lane] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes + 4 * lane));
+    }
+
+    for (int round = 0; round < 24; ++round) {
+        __m256i c[5];
+        __m256i d[5];
+        __m256i b[25];
+
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; ++x) {
+            c[x] = _mm256_xor_si256(_mm256_xor_si256(a[x], a[x + 5]),
+                                    _mm256_xor_si256(_mm256_xor_si256(a[x + 10], a[x + 15]), a[x + 20]));
+        }
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; ++x) {
+            d[x] = _mm256_xor_si256(c[(x + 4) % 5], rotlX4(c[(x + 1) % 5], 1));
+        }
+
+#pragma GCC unroll 25
+        for (int lane = 0; lane < 25; ++lane) {
+            b[piDestination(lane)] = rotlX4(_mm256_xor_si256(a[lane], d[lane % 5]), RHO[lane]);
+        }
+
+#pragma GCC unroll 5
+        for (int y = 0; y < 25; y += 5) {
+#pragma GCC unroll 5
+            for (int x = 0; x < 5; ++x) {
+                a[y + x] = _mm256_xor_si256(b[y + x], _mm256_andnot_si256(b[y + (x + 1) % 5], b[y + (x + 2) % 5]));
+            }
+        }
+
+        a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(static_cast<long long>(ROUND_CONSTANTS[round])));
+    }
+
+    for (int lane = 0; lane < 25; ++lane) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + 4 * lane), a[lane]);
+    }
+}
+
+__attribute__((target("avx512f")))
+void permuteX8Avx512(uint64_t* lanes) {
+    __m512i a[25];
+    for (int lane = 0; lane < 25; ++lane) {
+        a[lane] = _mm512_loadu_si512(lanes + 8 * lane);
+    }
+
+    for (int round = 0; round < 24; ++round) {
+        __m512i c[5];
+        __m512i d[5];
+        __m512i b[25];
+
+        // 0x96 = three-way XOR, 0xD2 = a ^ (~b & c). Rotations use the
+        // full-mask form of VPROLVQ, which needs no undefined source operand.
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; ++x) {
+            c[x] = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(a[x], a[x + 5], a[x + 10], 0x96),
+                                             a[x + 15], a[x + 20], 0x96);
+        }
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; ++x) {
+            d[x] = _mm512_xor_si512(c[(x + 4) % 5], _mm512_mask_rolv_epi64(c[(x + 1) % 5], 0xFF, c[(x + 1) % 5], _mm512_set1_epi64(1)));
+        }
+
+#pragma GCC unroll 25
+        for (int lane = 0; lane < 25; ++lane) {
+            __m512i t = _mm512_xor_si512(a[lane], d[lane % 5]);
+            b[piDestination(lane)] = _mm512_mask_rolv_epi64(t, 0xFF, t, _mm512_set1_epi64(RHO[lane]));
+        }
+
+#pragma GCC unroll 5
+        for (int y = 0; y < 25; y += 5) {
+#pragma GCC unroll 5
+            for (int x = 0; x < 5; ++x) {
+                a[y + x] = _mm512_ternarylogic_epi64(b[y + x], b[y + (x + 1) % 5], b[y + (x + 2) % 5], 0xD2);
+            }
+        }
+
+        a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64(static_cast<long long>(ROUND_CONSTANTS[round])));
+    }
+
+    for (int lane = 0; lane < 25; ++lane) {
+        _mm512_storeu_si512(lanes + 8 * lane, a[lane]);
+    }
+}
+#endif
+
+PermuteFn backendFunction(KeccakBackend backend) {
+    switch (backend) {
+        case KeccakBackend::Reference:
+            return &permuteReference;
+        case KeccakBackend::Opt64:
+            return &permuteOpt64;
+        case KeccakBackend::Opt64Bmi2:
+#if KNISHIO_KECCAK_X86
+            return &permuteOpt64Bmi2;
+#else
+            return nullptr;
+#endif
+    }
+    return nullptr;
+}
+
+void permuteFirstCall(void* state);
+
+// Constant-initialized, so the first permutation may safely happen during
+// static initialization of another translation unit
+std::atomic<PermuteFn> activePermute{&permuteFirstCall};
+std::atomic<KeccakBackend> activeBackend{KeccakBackend::Reference};
+
+void installBackend(KeccakBackend backend) {
+    activeBackend.store(backend, std::memory_order_relaxed);
+    activePermute.store(backendFunction(backend), std::memory_order_release);
+}
+
+void permuteFirstCall(void* state) {
+    installBackend(bestKeccakBackend());
+    activePermute.load(std::memory_order_acquire)(state);
+}
+
+} // namespace
+
+bool keccakBackendSupported(KeccakBackend backend) {
+    switch (backend) {
+        case KeccakBackend::Reference:
+            return true;
+        case KeccakBackend::Opt64:
+            // Lanes are copied straight out of the byte state
+            return std::endian::native == std::endian::little;
+        case KeccakBackend::Opt64Bmi2:
+#if KNISHIO_KECCAK_X86
+            return __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+KeccakBackend bestKeccakBackend() {
+    if (keccakBackendSupported(KeccakBackend::Opt64Bmi2)) {
+        return KeccakBackend::Opt64Bmi2;
+    }
+    if (keccakBackendSupported(KeccakBackend::Opt64)) {
+        return KeccakBackend::Opt64;
+    }
+    return KeccakBackend::Reference;
+}
+
+KeccakBackend activeKeccakBackend() {
+    if (activePermute.load(std::memory_order_acquire) == &permuteFirstCall) {
+        installBackend(bestKeccakBackend());
+    }
+    return activeBackend.load(std::memory_order_relaxed);
+}
+
+bool setKeccakBackend(KeccakBackend backend) {
+    if (!keccakBackendSupported(backend)) {
+        return false;
+    }
+    installBackend(backend);
+    return true;
+}
+
+const char* keccakBackendName(KeccakBackend backend) {
+    switch (backend) {
+        case KeccakBackend::Reference:
+            return "reference";
+        case KeccakBackend::Opt64:
+            return "opt64";
+        case KeccakBackend::Opt64Bmi2:
+            return "opt64-bmi2";
+    }
+    return "unknown";
+}
+
+void keccakF1600Permute(KeccakBackend backend, void* state) {
+    if (!keccakBackendSupported(backend)) {
+        throw std::invalid_argument(std::string("Keccak backend not supported: ") + keccakBackendName(backend));
+    }
+    backendFunction(backend)(state);
+}
+
+size_t keccakParallelWidth() {
+    if (keccakParallelWidthSupported(8)) {
+        return 8;
+    }
+    if (keccakParallelWidthSupported(4)) {
+        return 4;
+    }
+    return 1;
+}
+
+bool keccakParallelWidthSupported(size_t width) {
+    switch (width) {
+        case 1:
+            return true;
+#if KNISHIO_KECCAK_X86
+        case 4:
+            return __builtin_cpu_supports("avx2");
+        case 8:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+void keccakF1600PermuteInterleaved(uint64_t* lanes, size_t width) {
+#if KNISHIO_KECCAK_X86
+    if (width == 8 && keccakParallelWidthSupported(8)) {
+        permuteX8Avx512(lanes);
+        return;
+    }
+    if (width == 4 && keccakParallelWidthSupported(4)) {
+        permuteX4Avx2(lanes);
+        return;
+    }
+#endif
+
+    const KeccakBackend backend = activeKeccakBackend();
+
+    for (size_t k = 0; k < width; ++k) {
+        uint64_t state[25];
+        for (size_t lane = 0; lane < 25; ++lane) {
+            state[lane] = lanes[lane * width + k];
+        }
+
+        if (backend == KeccakBackend::Reference) {
+            // The reference permutation works on the little-endian byte image
+            unsigned char bytes[200];
+            for (size_t lane = 0; lane < 25; ++lane) {
+                for (size_t byte = 0; byte < 8; ++byte) {
+                    bytes[lane * 8 + byte] = static_cast<unsigned char>(state[lane] >> (8 * byte));
+                }
+            }
+            KeccakF1600_StatePermute(bytes);
+            for (size_t lane = 0; lane < 25; ++lane) {
+                uint64_t value = 0;
+                for (size_t byte = 8; byte-- > 0;) {
+                    value = (value << 8) | bytes[lane * 8 + byte];
+                }
+                state[lane] = value;
+            }
+        }
+#if KNISHIO_KECCAK_X86
+        else if (backend == KeccakBackend::Opt64Bmi2) {
+            permuteLanesBmi2(state);
+        }
+#endif
+        else {
+            permuteLanes(state);
+        }
+
+        for (size_t lane = 0; lane < 25; ++lane) {
+            lanes[lane * width + k] = state[lane];
+        }
+    }
+}
+
+} // namespace knishio
+
+void KeccakF1600_Permute(void *state)
+{
+    knishio::activePermute.load(std::memory_order_acquire)(state);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace knishio {
+
+/**
+ * Keccak-f[1600] permutation backends
+ *
+ * Every SHAKE256 call (FIPS202_SHAKE256 and knishio::Shake256) permutes
+ * through KeccakF1600_Permute(), which forwards to the backend selected
+ * here. The best supported backend is picked at startup from the running
+ * CPU; Reference is the vendored readable-and-compact permutation and is
+ * always available as a fallback.
+ */
+enum class KeccakBackend {
+    Reference,  ///< Vendored readable-and-compact implementation
+    Opt64,      ///< Unrolled 64-bit lane implementation (little-endian hosts)
+    Opt64Bmi2   ///< Opt64 compiled for BMI1/BMI2 (ANDN/RORX), x86-64 only
+};
+
+/**
+ * Backend currently used by KeccakF1600_Permute()
+ */
+KeccakBackend activeKeccakBackend();
+
+/**
+ * Select the permutation backend
+ * @param backend Backend to use
+ * @return false (and no change) if the backend is not supported on this CPU/build
+ */
+bool setKeccakBackend(KeccakBackend backend);
+
+/**
+ * Whether a backend can run on this CPU/build
+ * @param backend Backend to check
+ */
+bool keccakBackendSupported(KeccakBackend backend);
+
+/**
+ * Fastest backend supported on this CPU/build
+ */
+KeccakBackend bestKeccakBackend();
+
+/**
+ * Human-readable backend name ("reference", "opt64", "opt64-bmi2")
+ */
+const char* keccakBackendName(KeccakBackend backend);
+
+/**
+ * Run one permutation with an explicit backend, bypassing dispatch
+ * (used to cross-check backends against each other)
+ * @param backend Backend to use; must be supported
+ * @param state 200-byte state in little-endian lane order
+ * @throws std::invalid_argument if the backend is not supported
+ */
+void keccakF1600Permute(KeccakBackend backend, void* state);
+
+/**
+ * Widest multi-state kernel supported on this CPU/build: 8 (AVX-512F),
+ * 4 (AVX2) or 1 (no SIMD kernel; states are permuted one by one)
+ */
+size_t keccakParallelWidth();
+
+/**
+ * Whether keccakF1600PermuteInterleaved() has a SIMD kernel for this width
+ * @param width 4 or 8 (1 is always supported)
+ */
+bool keccakParallelWidthSupported(size_t width);
+
+/**
+ * Permute `width` independent Keccak states stored lane-interleaved: lane i
+ * of state k lives at lanes[i * width + k] (25 * width values, native
+ * integers). Widths without a SIMD kernel fall back to one permutation per
+ * state through KeccakF1600_Permute().
+ * @param lanes Interleaved lane array
+ * @param width Number of states (1, 4 or 8 use SIMD kernels when available)
+ */
+void keccakF1600PermuteInterleaved(uint64_t* lanes, size_t width);
+
+} // namespace knishio
@@ -0,0 +1,128 @@
+#include "mlkem.h"
+
+#ifdef HAVE_MLKEM_NATIVE
+
+#include <atomic>
+
+extern "C" {
+    // mlkem-native configuration for ML-KEM768
+    #define MLK_CONFIG_API_PARAMETER_SET 768
+    #define MLK_CONFIG_API_NAMESPACE_PREFIX mlkem
+    #include "mlkem_native.h"
+
+#ifdef KNISHIO_MLKEM_NATIVE_BACKEND
+    // The same API from the build with the x86_64 backends (MLK_CONFIG_NAMESPACE_PREFIX=mlkem_avx2)
+    int mlkem_avx2_keypair_derand(uint8_t* pk, uint8_t* sk, const uint8_t* coins);
+    int mlkem_avx2_enc(uint8_t* ct, uint8_t* ss, const uint8_t* pk);
+    int mlkem_avx2_dec(uint8_t* ss, const uint8_t* ct, const uint8_t* sk);
+#endif
+}
+
+namespace knishio {
+
+namespace {
+
+struct KemFunctions {
+    int (*keypairDerand)(uint8_t*, uint8_t*, const uint8_t*);
+    int (*encapsulate)(uint8_t*, uint8_t*, const uint8_t*);
+    int (*decapsulate)(uint8_t*, const uint8_t*, const uint8_t*);
+};
+
+const KemFunctions PORTABLE = {&crypto_kem_keypair_derand, &crypto_kem_enc, &crypto_kem_dec};
+#ifdef KNISHIO_MLKEM_NATIVE_BACKEND
+const KemFunctions AVX2 = {&mlkem_avx2_keypair_derand, &mlkem_avx2_enc, &mlkem_avx2_dec};
+#endif
+
+const KemFunctions* backendFunctions(MlkemBackend backend) {
+    switch (backend) {
+        case MlkemBackend::Portable:
+            return &PORTABLE;
+        case MlkemBackend::Avx2:
+#ifdef KNISHIO_MLKEM_NATIVE_BACKEND
+            return &AVX2;
+#else
+            return nullptr;
+#endif
+    }
+    return nullptr;
+}
+
+// Null until the first KEM call (or activeMlkemBackend()) picks the best backend
+std::atomic<const KemFunctions*> activeFunctions{nullptr};
+std::atomic<MlkemBackend> activeBackend{MlkemBackend::Portable};
+
+void installBackend(MlkemBackend backend) {
+    activeBackend.store(backend, std::memory_order_relaxed);
+    activeFunctions.store(backendFunctions(backend), std::memory_order_release);
+}
+
+const KemFunctions& active() {
+    const KemFunctions* functions = activeFunctions.load(std::memory_order_acquire);
+    if (functions == nullptr) {
+        installBackend(bestMlkemBackend());
+        functions = activeFunctions.load(std::memory_order_acquire);
+    }
+    return *functions;
+}
+
+} // namespace
+
+bool mlkemBackendSupported(MlkemBackend backend) {
+    switch (backend) {
+        case MlkemBackend::Portable:
+            return true;
+        case MlkemBackend::Avx2:
+#ifdef KNISHIO_MLKEM_NATIVE_BACKEND
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+MlkemBackend bestMlkemBackend() {
+    if (mlkemBackendSupported(MlkemBackend::Avx2)) {
+        return MlkemBackend::Avx2;
+    }
+    return MlkemBackend::Portable;
+}
+
+MlkemBackend activeMlkemBackend() {
+    active();
+    return activeBackend.load(std::memory_order_relaxed);
+}
+
+bool setMlkemBackend(MlkemBackend backend) {
+    if (!mlkemBackendSupported(backend)) {
+        return false;
+    }
+    installBackend(backend);
+    return true;
+}
+
+const char* mlkemBackendName(MlkemBackend backend) {
+    switch (backend) {
+        case MlkemBackend::Portable:
+            return "portable";
+        case MlkemBackend::Avx2:
+            return "avx2";
+    }
+    return "unknown";
+}
+
+int mlkem768KeypairDerand(uint8_t* publicKey, uint8_t* secretKey, const uint8_t* coins) {
+    return active().keypairDerand(publicKey, secretKey, coins);
+}
+
+int mlkem768Encapsulate(uint8_t* cipherText, uint8_t* sharedSecret, const uint8_t* publicKey) {
+    return active().encapsulate(cipherText, sharedSecret, publicKey);
+}
+
+int mlkem768Decapsulate(uint8_t* sharedSecret, const uint8_t* cipherText, const uint8_t* secretKey) {
+    return active().decapsulate(sharedSecret, cipherText, secretKey);
+}
+
+} // namespace knishio
+
+#endif // HAVE_MLKEM_NATIVE
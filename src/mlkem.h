@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+namespace knishio {
+
+/**
+ * ML-KEM768 (FIPS 203) backends
+ *
+ * Wallet runs key generation, encapsulation and decapsulation through the
+ * functions below, which forward to the backend selected here. Portable is
+ * mlkem-native compiled as plain C and is always available. Built with
+ * KNISHIO_MLKEM_NATIVE_BACKEND, mlkem-native is compiled a second time with
+ * its x86_64 backends (AVX2 arithmetic, Keccak x4) under its own namespace;
+ * that build is picked at startup when the running CPU has AVX2 and BMI2.
+ * Both produce identical bytes.
+ *
+ * Sizes: public key 1184, secret key 2400, ciphertext 1088, shared secret 32,
+ * keygen coins 64 bytes. The KEM functions return 0 on success.
+ */
+enum class MlkemBackend {
+    Portable,   ///< mlkem-native, portable C
+    Avx2        ///< mlkem-native with its x86_64 AVX2 arithmetic and Keccak x4 backends
+};
+
+/**
+ * Backend currently used by the KEM functions
+ */
+MlkemBackend activeMlkemBackend();
+
+/**
+ * Select the backend
+ * @param backend Backend to use
+ * @return false (and no change) if the backend is not supported on this CPU/build
+ */
+bool setMlkemBackend(MlkemBackend backend);
+
+/**
+ * Whether a backend can run on this CPU/build
+ * @param backend Backend to check
+ */
+bool mlkemBackendSupported(MlkemBackend backend);
+
+/**
+ * Fastest backend supported on this CPU/build
+ */
+MlkemBackend bestMlkemBackend();
+
+/**
+ * Human-readable backend name ("portable", "avx2")
+ */
+const char* mlkemBackendName(MlkemBackend backend);
+
+/**
+ * Deterministic key generation from 64 bytes of coins (d ‖ z)
+ */
+int mlkem768KeypairDerand(uint8_t* publicKey, uint8_t* secretKey, const uint8_t* coins);
+
+/**
+ * Encapsulation against a public key: writes the ciphertext and the shared secret
+ */
+int mlkem768Encapsulate(uint8_t* cipherText, uint8_t* sharedSecret, const uint8_t* publicKey);
+
+/**
+ * Decapsulation of a ciphertext with a secret key
+ */
+int mlkem768Decapsulate(uint8_t* sharedSecret, const uint8_t* cipherText, const uint8_t* secretKey);
+
+} // namespace knishio
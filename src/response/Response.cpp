@@ -19,6 +19,251 @@ nlohmann::json parseProposePayload(const nlohmann::json& data) {
     }
     return nlohmann::json::object();
 }
+
+/**
+ * SAX handler that tracks where in the document each event occurs. Subclasses match the
+ * current path against the response shape they know and copy out only the strings they need,
+ * so no JSON tree is built. Paths are relative to the GraphQL "data" member when present;
+ * array elements appear as "[]" and "*" in a pattern matches any key.
+ */
+class PathSax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    bool null() override { return scalar(); }
+    bool boolean(bool) override { return scalar(); }
+    bool number_integer(number_integer_t) override { return scalar(); }
+    bool number_unsigned(number_unsigned_t) override { return scalar(); }
+    bool number_float(number_float_t, const string_t&) override { return scalar(); }
+    bool binary(binary_t&) override { return scalar(); }
+
+    bool string(string_t& value) override {
+        onString(value);
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        onStartObject();
+        push(false);
+        return true;
+    }
+
+    bool key(string_t& name) override {
+        frames_[depth_ - 1].key.assign(name);
+        return true;
+    }
+
+    bool end_object() override {
+        depth_--;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        push(true);
+        return true;
+    }
+
+    bool end_array() override {
+        depth_--;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+protected:
+    virtual void onString(std::string& value) = 0;
+    virtual void onStartObject() {}
+
+    // Whether the current value sits at @p pattern
+    bool at(std::initializer_list<std::string_view> pattern) const {
+        size_t first = (depth_ > 0 && !frames_[0].array && frames_[0].key == "data") ? 1 : 0;
+        if (depth_ - first != pattern.size()) {
+            return false;
+        }
+        size_t level = first;
+        for (std::string_view expected : pattern) {
+            const Frame& frame = frames_[level++];
+            if (frame.array ? expected != "[]" : (expected != "*" && expected != frame.key)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Key of the innermost object member
+    const std::string& currentKey() const {
+        return frames_[depth_ - 1].key;
+    }
+
+private:
+    struct Frame {
+        bool array = false;
+        std::string key;        // member being parsed (objects); kept across members to reuse capacity
+    };
+
+    bool scalar() {
+        return true;
+    }
+
+    void push(bool array) {
+        if (frames_.size() == depth_) {
+            frames_.emplace_back();
+        }
+        frames_[depth_].array = array;
+        frames_[depth_].key.clear();
+        depth_++;
+    }
+
+    std::vector<Frame> frames_;
+    size_t depth_ = 0;
+};
+
+class BalanceSax : public PathSax {
+public:
+    explicit BalanceSax(std::optional<ResponseBalance::Balance>& balance) : balance_(balance) {}
+
+protected:
+    void onStartObject() override {
+        if (at({"Balance"})) {
+            balance_.emplace();
+        } else if (balance_ && at({"Balance", "tokenUnits", "[]"})) {
+            balance_->tokenUnits.emplace_back();
+        }
+    }
+
+    void onString(std::string& value) override {
+        if (!balance_) {
+            return;
+        }
+        auto& b = *balance_;
+        if (at({"Balance", "*"})) {
+            const auto& field = currentKey();
+            if (field == "address") b.address = std::move(value);
+            else if (field == "bundleHash") b.bundleHash = std::move(value);
+            else if (field == "tokenSlug") b.tokenSlug = std::move(value);
+            else if (field == "amount") b.amount = std::move(value);
+            else if (field == "position") b.position = std::move(value);
+            else if (field == "batchId") b.batchId = std::move(value);
+            // The validator returns `characters` as a single String; arrays are handled below
+            else if (field == "characters") b.characters.push_back(std::move(value));
+        } else if (at({"Balance", "characters", "[]"})) {
+            b.characters.push_back(std::move(value));
+        } else if (!b.tokenUnits.empty() && at({"Balance", "tokenUnits", "[]", "*"})) {
+            const auto& field = currentKey();
+            if (field == "id") b.tokenUnits.back().id = std::move(value);
+            else if (field == "name") b.tokenUnits.back().name = std::move(value);
+        } else if (!b.tokenUnits.empty() && at({"Balance", "tokenUnits", "[]", "metas", "*"})) {
+            b.tokenUnits.back().metas[currentKey()] = std::move(value);
+        }
+    }
+
+private:
+    std::optional<ResponseBalance::Balance>& balance_;
+};
+
+class WalletListSax : public PathSax {
+public:
+    explicit WalletListSax(std::vector<ResponseWalletList::Wallet>& wallets) : wallets_(wallets) {}
+
+protected:
+    void onStartObject() override {
+        if (at({"wallets", "[]"}) || at({"WalletList", "[]"})) {
+            wallets_.emplace_back();
+            hasTokenSlug_ = false;
+            hasBalance_ = false;
+        }
+    }
+
+    void onString(std::string& value) override {
+        if (wallets_.empty() || !(at({"wallets", "[]", "*"}) || at({"WalletList", "[]", "*"}))) {
+            return;
+        }
+        auto& w = wallets_.back();
+        const auto& field = currentKey();
+        if (field == "address") {
+            w.address = std::move(value);
+        } else if (field == "bundleHash") {
+            w.bundleHash = std::move(value);
+        } else if (field == "tokenSlug") {
+            // Validator returns `tokenSlug`; tolerate `token`.
+            w.token = std::move(value);
+            hasTokenSlug_ = true;
+        } else if (field == "token") {
+            if (!hasTokenSlug_) w.token = std::move(value);
+        } else if (field == "position") {
+            w.position = std::move(value);
+        } else if (field == "pubkey") {
+            w.pubkey = std::move(value);
+        } else if (field == "balance") {
+            w.balance = std::move(value);
+            hasBalance_ = true;
+        } else if (field == "amount") {
+            if (!hasBalance_) w.balance = std::move(value);
+        }
+    }
+
+private:
+    std::vector<ResponseWalletList::Wallet>& wallets_;
+    bool hasTokenSlug_ = false;
+    bool hasBalance_ = false;
+};
+
+class ContinuIdSax : public PathSax {
+public:
+    explicit ContinuIdSax(std::optional<ResponseContinuId::ContinuID>& continuId) : continuId_(continuId) {}
+
+protected:
+    void onStartObject() override {
+        if (at({"ContinuId"})) {
+            continuId_.emplace();
+        }
+    }
+
+    void onString(std::string& value) override {
+        if (!continuId_ || !at({"ContinuId", "*"})) {
+            return;
+        }
+        const auto& field = currentKey();
+        if (field == "position") continuId_->position = std::move(value);
+        else if (field == "address") continuId_->walletAddress = std::move(value);
+        else if (field == "bundleHash") continuId_->bundle = std::move(value);
+    }
+
+private:
+    std::optional<ResponseContinuId::ContinuID>& continuId_;
+};
+
+class ProposeMoleculeSax : public PathSax {
+public:
+    explicit ProposeMoleculeSax(nlohmann::json& fields) : fields_(fields) {}
+
+protected:
+    void onStartObject() override {
+        if (at({"ProposeMolecule"})) {
+            fields_ = nlohmann::json::object();
+        }
+    }
+
+    void onString(std::string& value) override {
+        if (!fields_.is_object() || !at({"ProposeMolecule", "*"})) {
+            return;
+        }
+        const auto& field = currentKey();
+        if (field == "molecularHash" || field == "status" || field == "reason" ||
+            field == "payload" || field == "createdAt") {
+            fields_[field] = std::move(value);
+        }
+    }
+
+private:
+    nlohmann::json& fields_;
+};
+
+// Strict, like json::parse: trailing content after the document is an error
+bool runSax(std::string_view body, PathSax& handler) {
+    return nlohmann::json::sax_parse(body.begin(), body.end(), &handler,
+                                     nlohmann::json::input_format_t::json, true);
+}
 } // anonymous namespace
 
 // ResponseBalance implementation
@@ -52,7 +297,7 @@ void ResponseBalance::parseData() {
         }
 
         // Stackable (NFT) units the wallet holds. Canonical shape: tokenUnits[{id,name,metas}].
-        // Mirrors KnishIOClient.cpp::parseWalletTokenUnits so a C++ consumer can read units back
+        // BalanceSax reads the same shape when parsing straight from the response body
         // (the validator serves Wallet.tokenUnits as of the stackable Phase-1 work).
         if (balanceData.contains("tokenUnits") && balanceData["tokenUnits"].is_array()) {
             for (const auto& u : balanceData["tokenUnits"]) {
@@ -72,6 +317,16 @@ void ResponseBalance::parseData() {
     }
 }
 
+bool ResponseBalance::parseBody(std::string_view body) {
+    balance.reset();
+    BalanceSax handler(balance);
+    if (!runSax(body, handler)) {
+        balance.reset();
+        return false;
+    }
+    return true;
+}
+
 // ResponseWalletList implementation
 void ResponseWalletList::parseData() {
     wallets.clear();
@@ -106,6 +361,16 @@ void ResponseWalletList::parseData() {
     }
 }
 
+bool ResponseWalletList::parseBody(std::string_view body) {
+    wallets.clear();
+    WalletListSax handler(wallets);
+    if (!runSax(body, handler)) {
+        wallets.clear();
+        return false;
+    }
+    return true;
+}
+
 // ResponseContinuId implementation
 void ResponseContinuId::parseData() {
     if (data.contains("ContinuId") && data["ContinuId"].is_object()) {
@@ -125,6 +390,16 @@ void ResponseContinuId::parseData() {
     }
 }
 
+bool ResponseContinuId::parseBody(std::string_view body) {
+    continuId.reset();
+    ContinuIdSax handler(continuId);
+    if (!runSax(body, handler)) {
+        continuId.reset();
+        return false;
+    }
+    return true;
+}
+
 // ResponseCreateToken implementation
 bool ResponseCreateToken::isCreated() const {
     // createToken submits a ProposeMolecule (C-isotope token-creation), so the response is
@@ -226,5 +501,26 @@ std::string ResponseProposeMolecule::getRejectionReason() const {
     return "";
 }
 
+bool ResponseProposeMolecule::parseBody(std::string_view body) {
+    nlohmann::json fields;
+    ProposeMoleculeSax handler(fields);
+    if (!runSax(body, handler)) {
+        return false;
+    }
+    data = nlohmann::json::object();
+    if (fields.is_object()) {
+        data["ProposeMolecule"] = std::move(fields);
+    }
+    // GraphQL errors stay in the data, as with the tree parser; a body that never mentions
+    // them (every accepted molecule) isn't parsed twice
+    if (body.find("\"errors\"") != std::string_view::npos) {
+        auto document = nlohmann::json::parse(body);
+        if (document.is_object() && document.contains("errors")) {
+            data["errors"] = std::move(document["errors"]);
+        }
+    }
+    return true;
+}
+
 } // namespace response
-} // namespace knishio
\ No newline at end of file
+} // namespace knishio
@@ -0,0 +1,146 @@
+#include "shake256.h"
+
+#include "encoding.h"
+#include "third_party/Keccak/Keccak.h"
+
+#include <sodium.h>
+#include <stdexcept>
+#include <cstring>
+
+namespace knishio {
+
+namespace {
+
+// SHAKE domain separation suffix (1111) plus the first padding bit
+constexpr unsigned char SHAKE_SUFFIX = 0x1F;
+
+} // namespace
+
+Shake256::Shake256() noexcept {
+    reset();
+}
+
+Shake256::~Shake256() {
+    sodium_memzero(state_, sizeof(state_));
+}
+
+void Shake256::reset() noexcept {
+    std::memset(state_, 0, sizeof(state_));
+    offset_ = 0;
+    squeezing_ = false;
+}
+
+Shake256& Shake256::update(std::span<const unsigned char> data) {
+    if (squeezing_) {
+        throw std::logic_error("Shake256::update called after finalize");
+    }
+
+    const unsigned char* in = data.data();
+    size_t remaining = data.size();
+
+    while (remaining > 0) {
+        size_t take = RATE - offset_;
+        if (take > remaining) {
+            take = remaining;
+        }
+
+        for (size_t i = 0; i < take; ++i) {
+            state_[offset_ + i] ^= in[i];
+        }
+
+        offset_ += take;
+        in += take;
+        remaining -= take;
+
+        if (offset_ == RATE) {
+            KeccakF1600_Permute(state_);
+            offset_ = 0;
+        }
+    }
+
+    return *this;
+}
+
+Shake256& Shake256::update(std::string_view data) {
+    return update(std::span<const unsigned char>(
+        reinterpret_cast<const unsigned char*>(data.data()), data.size()));
+}
+
+Shake256& Shake256::updateHex(std::span<const unsigned char> data) {
+    // Encode through a small stack buffer; 64 bytes -> one 128-char WOTS+ chunk
+    char buffer[128];
+
+    while (!data.empty()) {
+        size_t take = data.size() < sizeof(buffer) / 2 ? data.size() : sizeof(buffer) / 2;
+
+        hexEncode(data.first(take), buffer);
+        update(std::string_view(buffer, take * 2));
+        data = data.subspan(take);
+    }
+
+    sodium_memzero(buffer, sizeof(buffer));
+    return *this;
+}
+
+void Shake256::finalize(std::span<unsigned char> out) {
+    if (squeezing_) {
+        throw std::logic_error("Shake256::finalize called twice");
+    }
+
+    state_[offset_] ^= SHAKE_SUFFIX;
+    state_[RATE - 1] ^= 0x80;
+    KeccakF1600_Permute(state_);
+
+    offset_ = 0;
+    squeezing_ = true;
+    squeeze(out);
+}
+
+void Shake256::squeeze(std::span<unsigned char> out) {
+    if (!squeezing_) {
+        throw std::logic_error("Shake256::squeeze called before finalize");
+    }
+
+    unsigned char* dst = out.data();
+    size_t remaining = out.size();
+
+    while (remaining > 0) {
+        if (offset_ == RATE) {
+            KeccakF1600_Permute(state_);
+            offset_ = 0;
+        }
+
+        size_t take = RATE - offset_;
+        if (take > remaining) {
+            take = remaining;
+        }
+
+        std::memcpy(dst, state_ + offset_, take);
+        offset_ += take;
+        dst += take;
+        remaining -= take;
+    }
+}
+
+size_t Shake256::checkedByteLength(size_t bits) {
+    if (bits == 0 || bits % 8 != 0) {
+        throw std::invalid_argument("SHAKE256 bits size must be positive and divisible by 8");
+    }
+    return bits / 8;
+}
+
+std::vector<unsigned char> Shake256::digest(size_t bits) {
+    std::vector<unsigned char> output(checkedByteLength(bits));
+    finalize(output);
+    return output;
+}
+
+std::string Shake256::hexDigest(size_t bits) {
+    auto bytes = digest(bits);
+
+    std::string hex(bytes.size() * 2, '\0');
+    hexEncode(bytes, hex.data());
+    return hex;
+}
+
+} // namespace knishio
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+namespace knishio {
+
+/**
+ * Incremental SHAKE256 (FIPS 202) context
+ *
+ * Absorbs input in pieces and squeezes any number of output bytes, so hash
+ * callers can feed fields straight into the sponge instead of concatenating
+ * them into one large std::string first. Output is bit-identical to the
+ * one-shot shake256() in utility.h for the same byte stream.
+ *
+ * Typical use:
+ *   Shake256 sponge;
+ *   sponge.update(position).update(walletAddress);
+ *   sponge.finalize(out);          // pads and squeezes out.size() bytes
+ *
+ * The context is reusable after reset(). The state is wiped on destruction
+ * since the wallet-key paths absorb secret material.
+ */
+class Shake256 {
+public:
+    /** SHAKE256 rate in bytes (1600 - 2*256 bits) */
+    static constexpr size_t RATE = 136;
+
+    Shake256() noexcept;
+    Shake256(const Shake256& other) noexcept = default;
+    Shake256& operator=(const Shake256& other) noexcept = default;
+
+    /**
+     * Destructor - securely clears the sponge state
+     */
+    ~Shake256();
+
+    /**
+     * Return to the empty-message state
+     */
+    void reset() noexcept;
+
+    /**
+     * Absorb raw bytes
+     * @param data Input bytes
+     * @return *this for chaining
+     * @throws std::logic_error if called after finalize()
+     */
+    Shake256& update(std::span<const unsigned char> data);
+
+    /**
+     * Absorb the bytes of a string
+     * @param data Input text
+     * @return *this for chaining
+     */
+    Shake256& update(std::string_view data);
+
+    /**
+     * Absorb the lowercase hex encoding of data (as toHexString() would
+     * produce it) without materializing the encoded string
+     * @param data Bytes whose hex text is absorbed
+     * @return *this for chaining
+     */
+    Shake256& updateHex(std::span<const unsigned char> data);
+
+    /**
+     * Pad the message and squeeze the first out.size() output bytes.
+     * Further output may be read with squeeze().
+     * @param out Destination buffer
+     * @throws std::logic_error if already finalized
+     */
+    void finalize(std::span<unsigned char> out);
+
+    /**
+     * Squeeze the next out.size() output bytes (after finalize())
+     * @param out Destination buffer
+     * @throws std::logic_error if not finalized yet
+     */
+    void squeeze(std::span<unsigned char> out);
+
+    /**
+     * Finalize and return the digest
+     * @param bits Output length in bits (positive, divisible by 8)
+     * @return Digest bytes
+     */
+    std::vector<unsigned char> digest(size_t bits);
+
+    /**
+     * Finalize and return the digest as lowercase hex
+     * @param bits Output length in bits (positive, divisible by 8)
+     * @return Hex digest
+     */
+    std::string hexDigest(size_t bits);
+
+private:
+    alignas(8) unsigned char state_[200];
+    size_t offset_;
+    bool squeezing_;
+
+    static size_t checkedByteLength(size_t bits);
+};
+
+} // namespace knishio
@@ -280,6 +280,9 @@ that use the Keccak-f[1600] permutation.
 #include <string.h>
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
+/* KnishIO: the sponge permutes through the runtime-dispatched backend (src/keccak_dispatch.cpp) */
+void KeccakF1600_Permute(void *state);
+
 void Keccak(unsigned int rate, unsigned int capacity, const unsigned char *input, unsigned long long int inputByteLen, unsigned char delimitedSuffix, unsigned char *output, unsigned long long int outputByteLen)
 {
     UINT8 state[200];
@@ -302,7 +305,7 @@ void Keccak(unsigned int rate, unsigned int capacity, const unsigned char *input
         inputByteLen -= blockSize;
 
         if (blockSize == rateInBytes) {
-            KeccakF1600_StatePermute(state);
+            KeccakF1600_Permute(state);
             blockSize = 0;
         }
     }
@@ -312,11 +315,11 @@ void Keccak(unsigned int rate, unsigned int capacity, const unsigned char *input
     state[blockSize] ^= delimitedSuffix;
     /* If the first bit of padding is at position rate-1, we need a whole new block for the second bit of padding */
     if (((delimitedSuffix & 0x80) != 0) && (blockSize == (rateInBytes-1)))
-        KeccakF1600_StatePermute(state);
+        KeccakF1600_Permute(state);
     /* Add the second bit of padding */
     state[rateInBytes-1] ^= 0x80;
     /* Switch to the squeezing phase */
-    KeccakF1600_StatePermute(state);
+    KeccakF1600_Permute(state);
 
     /* === Squeeze out all the output blocks === */
     while(outputByteLen > 0) {
@@ -326,6 +329,6 @@ void Keccak(unsigned int rate, unsigned int capacity, const unsigned char *input
         outputByteLen -= blockSize;
 
         if (outputByteLen > 0)
-            KeccakF1600_StatePermute(state);
+            KeccakF1600_Permute(state);
     }
 }
\ No newline at end of file
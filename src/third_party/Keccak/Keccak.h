@@ -1,5 +1,11 @@
 #pragma once
 
+// Keccak-f[1600] over a 200-byte state in little-endian lane order.
+// KeccakF1600_StatePermute is the readable reference permutation below;
+// KeccakF1600_Permute dispatches to the fastest backend (keccak_dispatch.h).
+void KeccakF1600_StatePermute(void *state);
+void KeccakF1600_Permute(void *state);
+
 void Keccak(unsigned int rate, unsigned int capacity, const unsigned char *input, unsigned long long int inputByteLen, unsigned char delimitedSuffix
 	, unsigned char *output, unsigned long long int outputByteLen);
 
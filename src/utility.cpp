@@ -1,13 +1,12 @@
 #include "utility.h"
 
+#include "encoding.h"
 #include "third_party/BigInt/bigInt.h"
 #include "third_party/Keccak/Keccak.h"
 
 #include <random>
 #include <codecvt>
 #include <sodium.h>
-#include <sstream>
-#include <iomanip>
 #include <stdexcept>
 #include <cctype>
 #include <cmath>
@@ -77,54 +76,21 @@ std::string charsetBaseConvert(const std::string &hashHex, unsigned int baseFrom
 
 std::string toHexString(const std::vector<unsigned char> &data)
 {
-	std::ostringstream out;
-	out << std::hex << std::setfill('0');
-	
-	for (const auto& byte : data)
-	{
-		out << std::setw(2) << static_cast<unsigned int>(byte);
-	}
+	return toHexString(std::span<const unsigned char>(data));
+}
 
-	return out.str();
+std::string toHexString(std::span<const unsigned char> data)
+{
+	std::string out(knishio::hexEncodedLength(data.size()), '\0');
+	knishio::hexEncode(data, out.data());
+	return out;
 }
 
 std::vector<unsigned char> fromHexString(const std::string &str)
 {
-	// Validate input string length is even
-	if (str.size() % 2 != 0) {
-		throw std::invalid_argument("Hex string must have even length");
-	}
-
-	std::vector<unsigned char> bytes;
-	bytes.reserve(str.size() / 2);
-
-	for (size_t i = 0; i < str.size(); i += 2)
-	{
-		// Validate we have at least 2 characters
-		if (i + 1 >= str.size()) break;
-
-		// Extract 2-character hex substring
-		std::string hex_byte = str.substr(i, 2);
-		
-		// Validate hex characters
-		for (char c : hex_byte) {
-			if (!std::isxdigit(c)) {
-				throw std::invalid_argument("Invalid hex character: " + std::string(1, c));
-			}
-		}
-
-		// Safe conversion using strtoul with error checking
-		char* end_ptr = nullptr;
-		unsigned long value = std::strtoul(hex_byte.c_str(), &end_ptr, 16);
-		
-		// Check for conversion errors
-		if (end_ptr != hex_byte.c_str() + 2 || value > 255) {
-			throw std::invalid_argument("Invalid hex byte: " + hex_byte);
-		}
-
-		bytes.push_back(static_cast<unsigned char>(value));
-	}
-
+	// Throws std::invalid_argument on odd length or a non-hex character
+	std::vector<unsigned char> bytes(str.size() / 2);
+	knishio::hexDecode(str, bytes.data());
 	return bytes;
 }
 
@@ -235,62 +201,17 @@ std::wstring fromUtf8(const std::string &str)
 // =============================================================================
 
 std::string toBase64(const std::vector<uint8_t> &data) {
-    // Simple Base64 encoding implementation
-    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    std::string result;
-    
-    for (size_t i = 0; i < data.size(); i += 3) {
-        uint32_t value = 0;
-        int count = 0;
-        
-        for (int j = 0; j < 3 && i + j < data.size(); ++j) {
-            value = (value << 8) | data[i + j];
-            ++count;
-        }
-        
-        value <<= (3 - count) * 8;
-        
-        for (int j = 0; j < 4; ++j) {
-            if (j <= count) {
-                result += chars[(value >> (18 - j * 6)) & 0x3F];
-            } else {
-                result += '=';
-            }
-        }
-    }
-    
+    return toBase64(std::span<const uint8_t>(data));
+}
+
+std::string toBase64(std::span<const uint8_t> data) {
+    std::string result(knishio::base64EncodedLength(data.size()), '\0');
+    knishio::base64Encode(data, result.data());
     return result;
 }
 
 std::vector<uint8_t> fromBase64(const std::string &str) {
-    // Simple Base64 decoding implementation
-    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    std::vector<uint8_t> result;
-    
-    std::vector<int> table(256, -1);
-    for (size_t i = 0; i < chars.size(); ++i) {
-        table[static_cast<unsigned char>(chars[i])] = static_cast<int>(i);
-    }
-    
-    for (size_t i = 0; i < str.size(); i += 4) {
-        uint32_t value = 0;
-        int count = 0;
-        
-        for (int j = 0; j < 4 && i + j < str.size(); ++j) {
-            if (str[i + j] != '=') {
-                int index = table[static_cast<unsigned char>(str[i + j])];
-                if (index == -1) continue;
-                value = (value << 6) | index;
-                ++count;
-            }
-        }
-        
-        value <<= (4 - count) * 6;
-        
-        for (int j = 0; j < count - 1; ++j) {
-            result.push_back(static_cast<uint8_t>((value >> (16 - j * 8)) & 0xFF));
-        }
-    }
-    
+    std::vector<uint8_t> result(knishio::base64DecodedMaxLength(str.size()));
+    result.resize(knishio::base64Decode(str, result.data()));
     return result;
 }
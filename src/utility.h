@@ -2,14 +2,18 @@
 
 #include <string>
 #include <vector>
+#include <span>
 #include <cstdint>  // uint8_t in the declarations below — not transitively included on Linux (cycle 127)
 
 std::string charsetBaseConvert(const std::string &hashHex, unsigned int baseFrom, unsigned int baseTo, const char *baseToSymbolTable);
 
+// Codecs delegate to encoding.h, which also offers caller-buffer variants
 std::string toHexString(const std::vector<unsigned char> &data);
+std::string toHexString(std::span<const unsigned char> data);
 std::vector<unsigned char> fromHexString(const std::string &str);
 
 std::string toBase64(const std::vector<uint8_t> &data);
+std::string toBase64(std::span<const uint8_t> data);
 std::vector<uint8_t> fromBase64(const std::string &str);
 
 std::vector<std::string> chunkSubstr(const std::string &str, size_t size);
@@ -0,0 +1,201 @@
+#include "wots.h"
+
+#include "encoding.h"
+#include "keccak_dispatch.h"
+
+#include <sodium.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace knishio {
+
+namespace {
+
+constexpr size_t MAX_WIDTH = 8;
+constexpr size_t RATE = 136;
+constexpr size_t DIGEST_BYTES = WOTS_CHUNK_HEX_LENGTH / 2;
+
+// A chain value stays binary between steps; it only becomes hex text while
+// being absorbed (into a stack buffer) or when the chain is written out
+using ChainValue = std::array<unsigned char, DIGEST_BYTES>;
+using HexBlock = std::array<char, WOTS_CHUNK_HEX_LENGTH>;
+
+struct ChainSlot {
+    size_t chain = 0;
+    int remaining = 0;
+    bool active = false;
+    bool started = false;
+    ChainValue value{};
+};
+
+// Little-endian lane access: one 8-byte copy, byte-swapped only on big-endian hosts
+inline uint64_t littleEndian(uint64_t lane) {
+    if constexpr (std::endian::native == std::endian::big) {
+        uint64_t swapped = 0;
+        for (size_t i = 0; i < 8; ++i, lane >>= 8) {
+            swapped = (swapped << 8) | (lane & 0xFF);
+        }
+        return swapped;
+    }
+    return lane;
+}
+
+inline uint64_t loadLane(const unsigned char* bytes) {
+    uint64_t lane;
+    std::memcpy(&lane, bytes, sizeof(lane));
+    return littleEndian(lane);
+}
+
+inline void storeLane(unsigned char* bytes, uint64_t lane) {
+    lane = littleEndian(lane);
+    std::memcpy(bytes, &lane, sizeof(lane));
+}
+
+// SHAKE256 padding for a single-block message of `length` bytes
+void padBlock(uint64_t* lanes, size_t width, size_t slot, size_t length) {
+    lanes[(length / 8) * width + slot] ^= static_cast<uint64_t>(0x1F) << (8 * (length % 8));
+    lanes[((RATE - 1) / 8) * width + slot] ^= static_cast<uint64_t>(0x80) << (8 * ((RATE - 1) % 8));
+}
+
+// Chain start: the raw chunk text, any length below the rate
+void absorbText(uint64_t* lanes, size_t width, size_t slot, std::string_view text) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t full = text.size() / 8;
+    for (size_t lane = 0; lane < full; ++lane) {
+        lanes[lane * width + slot] ^= loadLane(bytes + 8 * lane);
+    }
+    if (const size_t tail = text.size() % 8) {
+        unsigned char last[8] = {};
+        std::memcpy(last, bytes + 8 * full, tail);
+        lanes[full * width + slot] ^= loadLane(last);
+    }
+    padBlock(lanes, width, slot, text.size());
+}
+
+// Chain step: hex text of the previous value, exactly 16 lanes
+void absorbValue(uint64_t* lanes, size_t width, size_t slot, const ChainValue& value, HexBlock& hex) {
+    hexEncode(value, hex.data());
+    const auto* bytes = reinterpret_cast<const unsigned char*>(hex.data());
+    for (size_t lane = 0; lane < WOTS_CHUNK_HEX_LENGTH / 8; ++lane) {
+        lanes[lane * width + slot] = loadLane(bytes + 8 * lane);
+    }
+    padBlock(lanes, width, slot, WOTS_CHUNK_HEX_LENGTH);
+}
+
+void squeezeValue(const uint64_t* lanes, size_t width, size_t slot, ChainValue& value) {
+    for (size_t lane = 0; lane < DIGEST_BYTES / 8; ++lane) {
+        storeLane(value.data() + 8 * lane, lanes[lane * width + slot]);
+    }
+}
+
+} // namespace
+
+size_t runWotsChains(std::span<const std::string_view> inputs, std::span<const int> steps,
+                     std::span<char> output, size_t width) {
+    if (inputs.size() != steps.size()) {
+        throw std::invalid_argument("WOTS chain inputs and steps must have the same length");
+    }
+    if (width == 0) {
+        width = keccakParallelWidth();
+    }
+    if (width > MAX_WIDTH) {
+        throw std::invalid_argument("WOTS chain width must be between 1 and 8");
+    }
+
+    // Scheduling state is kept per thread, so repeated calls (a signer or a
+    // verifier worker going through many molecules) reuse the same storage
+    thread_local std::vector<size_t> offsets;
+    thread_local std::vector<size_t> pending;
+
+    // Output offsets follow the input order regardless of completion order
+    offsets.resize(inputs.size());
+    size_t total = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (steps[i] > 0 && inputs[i].size() >= RATE) {
+            throw std::invalid_argument("WOTS chain input exceeds one SHAKE256 block");
+        }
+        offsets[i] = total;
+        total += steps[i] > 0 ? WOTS_CHUNK_HEX_LENGTH : inputs[i].size();
+    }
+    if (total > output.size()) {
+        throw std::invalid_argument("WOTS chain output buffer too small");
+    }
+
+    pending.clear();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (steps[i] > 0) {
+            pending.push_back(i);
+        } else {
+            std::memcpy(output.data() + offsets[i], inputs[i].data(), inputs[i].size());
+        }
+    }
+
+    // Longest chains first, so the tail of the schedule is as short as possible;
+    // pending is consumed from the back
+    std::stable_sort(pending.begin(), pending.end(), [&steps](size_t a, size_t b) {
+        return steps[a] < steps[b];
+    });
+
+    std::array<ChainSlot, MAX_WIDTH> slots{};
+    alignas(64) uint64_t lanes[25 * MAX_WIDTH];
+    HexBlock hex{};
+
+    for (;;) {
+        size_t activeCount = 0;
+        for (size_t k = 0; k < width; ++k) {
+            if (!slots[k].active && !pending.empty()) {
+                slots[k].chain = pending.back();
+                slots[k].remaining = steps[slots[k].chain];
+                slots[k].active = true;
+                slots[k].started = false;
+                pending.pop_back();
+            }
+            if (slots[k].active) {
+                ++activeCount;
+            }
+        }
+        if (activeCount == 0) {
+            break;
+        }
+
+        std::memset(lanes, 0, sizeof(uint64_t) * 25 * width);
+        for (size_t k = 0; k < width; ++k) {
+            if (!slots[k].active) {
+                continue;
+            }
+            if (slots[k].started) {
+                absorbValue(lanes, width, k, slots[k].value, hex);
+            } else {
+                absorbText(lanes, width, k, inputs[slots[k].chain]);
+                slots[k].started = true;
+            }
+        }
+
+        keccakF1600PermuteInterleaved(lanes, width);
+
+        for (size_t k = 0; k < width; ++k) {
+            if (!slots[k].active) {
+                continue;
+            }
+            squeezeValue(lanes, width, k, slots[k].value);
+            if (--slots[k].remaining == 0) {
+                hexEncode(slots[k].value, output.data() + offsets[slots[k].chain]);
+                slots[k].active = false;
+            }
+        }
+    }
+
+    // Chains run over private key material when signing
+    sodium_memzero(lanes, sizeof(lanes));
+    sodium_memzero(slots.data(), sizeof(slots));
+    sodium_memzero(hex.data(), hex.size());
+
+    return total;
+}
+
+} // namespace knishio
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace knishio {
+
+/**
+ * Length of one WOTS+ chain value as hex text (a 512-bit SHAKE256 output)
+ */
+constexpr size_t WOTS_CHUNK_HEX_LENGTH = 128;
+
+/**
+ * Advance independent WOTS+ hash chains
+ *
+ * Chain i starts from the text inputs[i] (a 128-character key or signature
+ * chunk) and applies steps[i] rounds of shake256Hex(value, 512). Chains are
+ * packed onto the multi-state Keccak kernels, keccakParallelWidth() chains
+ * per permutation; whenever a chain finishes, its slot is refilled with the
+ * next pending chain (longest first) so the kernel stays busy.
+ *
+ * Final values are written back to back into output: 128 hex characters per
+ * chain, or the untouched input when steps[i] <= 0 - the same string the
+ * per-chain shake256Hex() loop would concatenate.
+ *
+ * @param inputs Chain start values (at most 135 bytes each)
+ * @param steps Hash rounds per chain, same length as inputs
+ * @param output Destination for the concatenated chain values
+ * @param width Chains per permutation, 1-8 (0 = widest kernel available)
+ * @return Number of characters written to output
+ * @throws std::invalid_argument on mismatched sizes, oversized inputs, a bad width or a short output
+ */
+size_t runWotsChains(std::span<const std::string_view> inputs, std::span<const int> steps,
+                     std::span<char> output, size_t width = 0);
+
+} // namespace knishio
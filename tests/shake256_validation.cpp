@@ -3,7 +3,11 @@
 #include <vector>
 #include <cassert>
 #include <iomanip>
+#include <sstream>
 #include "../src/utility.h"
+#include "../src/shake256.h"
+#include "../src/keccak_dispatch.h"
+#include "../src/wots.h"
 #include "../src/Wallet.h"
 
 using namespace KnishIO;  // Wallet/utility symbols live in the KnishIO namespace
@@ -97,6 +101,144 @@ public:
         validateTest("Bundle generation (Charlie secret)", charlie_bundle_result, charlie_bundle_expected);
     }
     
+    /**
+     * Test the incremental sponge against the one-shot shake256() path
+     */
+    void testIncrementalSponge() {
+        std::cout << "\n=== Testing Incremental SHAKE256 Sponge ===" << std::endl;
+
+        // 300 bytes spans two rate blocks (136 bytes each) plus a partial block
+        std::string message;
+        for (int i = 0; i < 300; i++) {
+            message.push_back(static_cast<char>('a' + (i % 26)));
+        }
+        std::string expected = shake256Hex(message, 512);
+
+        // Every split point, including both block boundaries
+        bool allSplitsMatch = true;
+        for (size_t split = 0; split <= message.size(); split++) {
+            knishio::Shake256 sponge;
+            sponge.update(std::string_view(message).substr(0, split));
+            sponge.update(std::string_view(message).substr(split));
+            if (sponge.hexDigest(512) != expected) {
+                allSplitsMatch = false;
+                break;
+            }
+        }
+        validateTest("Incremental absorb at every split point", allSplitsMatch ? expected : "mismatch", expected);
+
+        // updateHex must absorb exactly what toHexString() produces
+        std::vector<unsigned char> bytes = shake256("KnishIO", 8192);
+        knishio::Shake256 hexSponge;
+        hexSponge.updateHex(bytes);
+        validateTest("updateHex matches toHexString input", hexSponge.hexDigest(256), shake256Hex(toHexString(bytes), 256));
+
+        // Squeezing in pieces yields the same stream as one long output
+        knishio::Shake256 squeezeSponge;
+        std::vector<unsigned char> head(100);
+        std::vector<unsigned char> tail(924);
+        squeezeSponge.update(message);
+        squeezeSponge.finalize(head);
+        squeezeSponge.squeeze(tail);
+        head.insert(head.end(), tail.begin(), tail.end());
+        validateTest("Piecewise squeeze (8192 bits)", toHexString(head), shake256Hex(message, 8192));
+    }
+
+    /**
+     * Cross-check every supported Keccak-f backend against the reference permutation
+     */
+    void testKeccakBackends() {
+        std::cout << "\n=== Testing Keccak-f[1600] Backends ===" << std::endl;
+
+        const knishio::KeccakBackend backends[] = {
+            knishio::KeccakBackend::Reference,
+            knishio::KeccakBackend::Opt64,
+            knishio::KeccakBackend::Opt64Bmi2
+        };
+        const knishio::KeccakBackend selected = knishio::activeKeccakBackend();
+        std::cout << "Active backend: " << knishio::keccakBackendName(selected) << std::endl;
+
+        std::vector<unsigned char> seedState(200);
+        for (size_t i = 0; i < seedState.size(); i++) {
+            seedState[i] = static_cast<unsigned char>(i * 131 + 7);
+        }
+        std::vector<unsigned char> expectedState = seedState;
+        for (int round = 0; round < 3; round++) {
+            knishio::keccakF1600Permute(knishio::KeccakBackend::Reference, expectedState.data());
+        }
+
+        // Multi-block input and output, hashed once on the reference backend
+        const std::string longInput(1000, 'k');
+        knishio::setKeccakBackend(knishio::KeccakBackend::Reference);
+        const std::string expectedLong = shake256Hex(longInput, 8192);
+
+        for (auto backend : backends) {
+            std::string name = knishio::keccakBackendName(backend);
+            if (!knishio::keccakBackendSupported(backend)) {
+                std::cout << "Skipping unsupported backend: " << name << "\n" << std::endl;
+                continue;
+            }
+
+            std::vector<unsigned char> state = seedState;
+            for (int round = 0; round < 3; round++) {
+                knishio::keccakF1600Permute(backend, state.data());
+            }
+            validateTest("Keccak-f permutation (" + name + ")", toHexString(state), toHexString(expectedState));
+
+            // Full SHAKE256 path through the dispatcher
+            knishio::setKeccakBackend(backend);
+            validateTest("SHAKE256('test', 256 bits) via " + name, shake256Hex("test", 256),
+                         "b54ff7255705a71ee2925e4a3e30e41aed489a579d5595e0df13e32e1e4dd202");
+            validateTest("SHAKE256(1000 bytes, 8192 bits) via " + name, shake256Hex(longInput, 8192), expectedLong);
+        }
+
+        knishio::setKeccakBackend(selected);
+    }
+
+    /**
+     * Test the batched WOTS+ chain runner against the per-chain string path
+     */
+    void testWotsChains() {
+        std::cout << "\n=== Testing Batched WOTS+ Chains ===" << std::endl;
+
+        std::string key = shake256Hex("wots-chain-key", 8192);
+        std::vector<std::string_view> chunks;
+        for (size_t offset = 0; offset < key.size(); offset += 128) {
+            chunks.push_back(std::string_view(key).substr(offset, 128));
+        }
+        // Every step count a signature can produce, including the 0 and 16 extremes
+        std::vector<int> steps(chunks.size());
+        for (size_t i = 0; i < steps.size(); i++) {
+            steps[i] = static_cast<int>((i * 7) % 17);
+        }
+
+        std::string expected;
+        for (size_t i = 0; i < chunks.size(); i++) {
+            std::string working(chunks[i]);
+            for (int step = 0; step < steps[i]; step++) {
+                working = shake256Hex(working, 512);
+            }
+            expected += working;
+        }
+
+        // The chain engine hex-encodes through a lookup table; check it against iostream formatting
+        std::vector<unsigned char> allBytes(256);
+        std::ostringstream streamHex;
+        for (size_t i = 0; i < allBytes.size(); i++) {
+            allBytes[i] = static_cast<unsigned char>(i);
+            streamHex << std::hex << std::setw(2) << std::setfill('0') << i;
+        }
+        validateTest("Lookup-table hex encoding (all byte values)", toHexString(allBytes), streamHex.str());
+
+        std::cout << "Widest kernel: x" << knishio::keccakParallelWidth() << std::endl;
+        for (size_t width : {size_t(1), size_t(3), size_t(4), size_t(8)}) {
+            std::string actual(chunks.size() * 128, '\0');
+            actual.resize(knishio::runWotsChains(chunks, steps, actual, width));
+            validateTest("WOTS+ chains, " + std::to_string(width) + " per permutation",
+                         shake256Hex(actual, 256), shake256Hex(expected, 256));
+        }
+    }
+
     /**
      * Test wallet address generation against canonical test vectors
      */
@@ -200,6 +342,9 @@ public:
         std::cout << "Testing against canonical test vectors for cross-SDK compatibility" << std::endl;
         
         testBasicSHAKE256();
+        testIncrementalSponge();
+        testKeccakBackends();
+        testWotsChains();
         testBundleGeneration();
         testWalletGeneration();
         